@@ -2,28 +2,346 @@
 // Exercises_08_ExpressionTemplates.cpp
 // =====================================================================================
 
+module;
+
+#if defined(__AVX2__)
+#define EX_SIMD_AVX2
+#include <immintrin.h>   // AVX2 (and FMA) intrinsics
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EX_SIMD_SSE2
+#include <emmintrin.h>   // SSE2 intrinsics
+#endif
+
 module modern_cpp_exercises:expression_templates;
 
 namespace Exercises_ExpressionTemplates {
 
+    // A single accumulator makes every addition wait for the previous one
+    // (and the compiler must not reorder floating-point additions).
+    // Several independent accumulators keep the adders busy.
+    constexpr size_t Accumulators{ 4 };
+
+    // scalar kernel - any arithmetic type
     template <typename T>
-    T scalarProduct(const std::vector<T>& a, const std::vector<T>& b)
+    T dotKernel(const T* a, const T* b, size_t count)
     {
-        T product{};
-        for (size_t i{}; i != a.size(); ++i) {
-            product += (a[i]) * (b[i]);
+        T sums[Accumulators]{};
+
+        size_t i{};
+        for (; i + Accumulators <= count; i += Accumulators) {
+            for (size_t k{}; k != Accumulators; ++k) {
+                sums[k] += a[i + k] * b[i + k];
+            }
+        }
+        for (; i != count; ++i) {
+            sums[0] += a[i] * b[i];
+        }
+
+        // pairwise: (sums[0] + sums[1]) + (sums[2] + sums[3]) for 4 accumulators
+        for (size_t width{ 1 }; width < Accumulators; width *= 2) {
+            for (size_t k{}; k + width < Accumulators; k += 2 * width) {
+                sums[k] += sums[k + width];
+            }
+        }
+        return sums[0];
+    }
+
+#if defined(EX_SIMD_AVX2)
+
+    inline __m256d multiplyAdd(__m256d a, __m256d b, __m256d c)
+    {
+#if defined(__FMA__) || defined(_MSC_VER)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+
+    inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c)
+    {
+#if defined(__FMA__) || defined(_MSC_VER)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    // 4 accumulators of 4 lanes each
+    inline double dotKernel(const double* a, const double* b, size_t count)
+    {
+        __m256d sum0{ _mm256_setzero_pd() }, sum1{ sum0 }, sum2{ sum0 }, sum3{ sum0 };
+
+        size_t i{};
+        for (; i + 16 <= count; i += 16) {
+            sum0 = multiplyAdd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), sum0);
+            sum1 = multiplyAdd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), sum1);
+            sum2 = multiplyAdd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), sum2);
+            sum3 = multiplyAdd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), sum3);
+        }
+        for (; i + 4 <= count; i += 4) {
+            sum0 = multiplyAdd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), sum0);
+        }
+
+        const __m256d sum{ _mm256_add_pd(_mm256_add_pd(sum0, sum1), _mm256_add_pd(sum2, sum3)) };
+        __m128d half{ _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1)) };
+        half = _mm_add_sd(half, _mm_unpackhi_pd(half, half));
+
+        double product{ _mm_cvtsd_f64(half) };
+        for (; i != count; ++i) {
+            product += a[i] * b[i];
         }
         return product;
     }
 
+    // 4 accumulators of 8 lanes each
+    inline float dotKernel(const float* a, const float* b, size_t count)
+    {
+        __m256 sum0{ _mm256_setzero_ps() }, sum1{ sum0 }, sum2{ sum0 }, sum3{ sum0 };
+
+        size_t i{};
+        for (; i + 32 <= count; i += 32) {
+            sum0 = multiplyAdd(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+            sum1 = multiplyAdd(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+            sum2 = multiplyAdd(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), sum2);
+            sum3 = multiplyAdd(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), sum3);
+        }
+        for (; i + 8 <= count; i += 8) {
+            sum0 = multiplyAdd(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+        }
+
+        const __m256 sum{ _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3)) };
+        __m128 quarter{ _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1)) };
+        quarter = _mm_add_ps(quarter, _mm_movehl_ps(quarter, quarter));
+        quarter = _mm_add_ss(quarter, _mm_shuffle_ps(quarter, quarter, 1));
+
+        float product{ _mm_cvtss_f32(quarter) };
+        for (; i != count; ++i) {
+            product += a[i] * b[i];
+        }
+        return product;
+    }
+
+#elif defined(EX_SIMD_SSE2)
+
+    // 4 accumulators of 2 lanes each
+    inline double dotKernel(const double* a, const double* b, size_t count)
+    {
+        __m128d sum0{ _mm_setzero_pd() }, sum1{ sum0 }, sum2{ sum0 }, sum3{ sum0 };
+
+        size_t i{};
+        for (; i + 8 <= count; i += 8) {
+            sum0 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)), sum0);
+            sum1 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)), sum1);
+            sum2 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)), sum2);
+            sum3 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)), sum3);
+        }
+        for (; i + 2 <= count; i += 2) {
+            sum0 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)), sum0);
+        }
+
+        __m128d sum{ _mm_add_pd(_mm_add_pd(sum0, sum1), _mm_add_pd(sum2, sum3)) };
+        sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+        double product{ _mm_cvtsd_f64(sum) };
+        for (; i != count; ++i) {
+            product += a[i] * b[i];
+        }
+        return product;
+    }
+
+    // 4 accumulators of 4 lanes each
+    inline float dotKernel(const float* a, const float* b, size_t count)
+    {
+        __m128 sum0{ _mm_setzero_ps() }, sum1{ sum0 }, sum2{ sum0 }, sum3{ sum0 };
+
+        size_t i{};
+        for (; i + 16 <= count; i += 16) {
+            sum0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), sum0);
+            sum1 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)), sum1);
+            sum2 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)), sum2);
+            sum3 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)), sum3);
+        }
+        for (; i + 4 <= count; i += 4) {
+            sum0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), sum0);
+        }
+
+        __m128 sum{ _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3)) };
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+
+        float product{ _mm_cvtss_f32(sum) };
+        for (; i != count; ++i) {
+            product += a[i] * b[i];
+        }
+        return product;
+    }
+
+#endif
+
+    template <typename T>
+    T scalarProduct(std::span<const T> a, std::span<const T> b)
+    {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("scalarProduct: vectors differ in size");
+        }
+
+        return dotKernel(a.data(), b.data(), a.size());
+    }
+
     template <typename T>
     T scalarProductEx(typename std::vector<T>::iterator&& a, typename std::vector<T>::iterator&& end, typename std::vector<T>::iterator&& b)
     {
-        T product{};
-        for (; a != end; ++a, ++b) {
-            product += (*a) * (*b);
+        const std::span<const T> lhs{ a, end };
+        return scalarProduct<T>(lhs, std::span<const T>{ b, lhs.size() });
+    }
+
+    // worker threads started once and reused by every call - the calling thread
+    // takes part in the work, too, so 'hardware_concurrency() - 1' workers are started
+    class WorkerPool
+    {
+    private:
+        std::vector<std::jthread> m_workers;
+        std::mutex m_mutex;
+        std::mutex m_callMutex;
+        std::condition_variable_any m_cvWork;
+        std::condition_variable m_cvDone;
+
+        const std::function<void(size_t)>* m_task;
+        std::atomic<size_t> m_next;
+        size_t m_count;
+        size_t m_pending;
+        size_t m_generation;
+
+    public:
+        WorkerPool(size_t workers)
+            : m_task{}, m_next{}, m_count{}, m_pending{}, m_generation{}
+        {
+            for (size_t i{}; i != workers; ++i) {
+                m_workers.emplace_back([this](std::stop_token token) { run(token); });
+            }
         }
-        return product;
+
+        ~WorkerPool()
+        {
+            for (auto& worker : m_workers) {
+                worker.request_stop();
+            }
+            m_cvWork.notify_all();
+
+            // join before the mutexes and condition variables are destroyed
+            m_workers.clear();
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        static WorkerPool& instance()
+        {
+            static WorkerPool pool{ std::max(std::thread::hardware_concurrency(), 1u) - 1 };
+            return pool;
+        }
+
+        // invokes task(0), ..., task(count - 1) and returns when all of them are done
+        void parallelFor(size_t count, const std::function<void(size_t)>& task)
+        {
+            std::lock_guard<std::mutex> call{ m_callMutex };
+
+            {
+                std::lock_guard<std::mutex> guard{ m_mutex };
+                m_task = &task;
+                m_count = count;
+                m_next = 0;
+                m_pending = m_workers.size();
+                ++m_generation;
+            }
+            m_cvWork.notify_all();
+
+            work();
+
+            std::unique_lock<std::mutex> guard{ m_mutex };
+            m_cvDone.wait(guard, [this] () { return m_pending == 0; });
+            m_task = nullptr;
+        }
+
+    private:
+        void run(std::stop_token token)
+        {
+            size_t generation{};
+
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> guard{ m_mutex };
+                    if (!m_cvWork.wait(guard, token, [&] () { return m_generation != generation; })) {
+                        return;  // stop requested
+                    }
+                    generation = m_generation;
+                }
+
+                work();
+
+                {
+                    std::lock_guard<std::mutex> guard{ m_mutex };
+                    --m_pending;
+                }
+                m_cvDone.notify_one();
+            }
+        }
+
+        void work()
+        {
+            for (size_t index{ m_next++ }; index < m_count; index = m_next++) {
+                (*m_task)(index);
+            }
+        }
+    };
+
+    // chunks of this size are summed up independently, the partial sums are combined
+    // pairwise - the result does not depend on the number of threads
+    constexpr size_t DotChunk{ 64 * 1024 };
+
+    template <typename T>
+    T scalarProductParallel(std::span<const T> a, std::span<const T> b,
+        size_t threads = std::thread::hardware_concurrency())
+    {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("scalarProductParallel: vectors differ in size");
+        }
+
+        const size_t count{ a.size() };
+        const size_t chunks{ (count + DotChunk - 1) / DotChunk };
+        if (chunks <= 1) {
+            return scalarProduct(a, b);
+        }
+
+        std::vector<T> partials(chunks);
+
+        auto sumChunk = [&](size_t c) {
+            const size_t first{ c * DotChunk };
+            partials[c] = dotKernel(a.data() + first, b.data() + first, std::min(DotChunk, count - first));
+        };
+
+        // 'workers' lanes, each one summing up every workers-th chunk: at most
+        // 'threads' threads of the pool take part
+        const size_t workers{ std::clamp<size_t>(threads, 1, chunks) };
+        if (workers == 1) {
+            for (size_t c{}; c != chunks; ++c) {
+                sumChunk(c);
+            }
+        }
+        else {
+            WorkerPool::instance().parallelFor(workers, [&](size_t lane) {
+                for (size_t c{ lane }; c < chunks; c += workers) {
+                    sumChunk(c);
+                }
+            });
+        }
+
+        for (size_t width{ 1 }; width < chunks; width *= 2) {
+            for (size_t c{}; c + width < chunks; c += 2 * width) {
+                partials[c] += partials[c + width];
+            }
+        }
+        return partials[0];
     }
 
     static void test_01()
@@ -32,6 +350,14 @@ namespace Exercises_ExpressionTemplates {
         std::vector<double> b{ 6, 7, 8, 9, 10 };
         std::cout << "scalarProduct<double>(a, b) = " << scalarProduct<double>(a, b) << std::endl; // 130
         std::cout << "scalarProduct<double>(a, b) = " << scalarProduct<double>(a, a) << std::endl; // 55
+
+        std::vector<double> c{ 1, 2, 3 };
+        try {
+            scalarProduct<double>(a, c);
+        }
+        catch (const std::invalid_argument& ex) {
+            std::cout << ex.what() << std::endl;     // vectors differ in size
+        }
     }
 
     static void test_02()
@@ -42,25 +368,80 @@ namespace Exercises_ExpressionTemplates {
         std::cout << "scalarProductEx<double>(a, b) = " << scalarProductEx<double>(a.begin(), a.end(), a.begin()) << std::endl; // 55
     }
 
-    // primary template
-    template <size_t N, typename T>
-    class ScalarProduct {
-    public:
-        static inline T result(
-            const typename std::vector<T>::const_iterator a,
-            const typename std::vector<T>::const_iterator b) {
-                return (*a) * (*b) + ScalarProduct<N - 1, T>::result(a + 1, b + 1);
+    // ===========================================================
+    // loop unrolling without recursion: one fold expression over an index_sequence
+    // (see Apply.cpp) instead of N nested class template instantiations
+
+    // calls func(std::integral_constant<size_t, I>{}) for I = 0, ..., N - 1
+    template <size_t N, typename TFunc>
+    constexpr void static_for(TFunc&& func)
+    {
+        [&] <size_t... I> (std::index_sequence<I...>) {
+            (func(std::integral_constant<size_t, I>{}), ...);
+        } (std::make_index_sequence<N>{});
+    }
+
+    // calls func(i) for i = 0, ..., count - 1: the body is unrolled 'Factor' times,
+    // the remaining 'count % Factor' iterations run one by one
+    template <size_t Factor, typename TFunc>
+    constexpr void unrolled_for(size_t count, TFunc&& func)
+    {
+        static_assert(Factor > 0, "unroll factor must be positive");
+
+        size_t i{};
+        for (; i + Factor <= count; i += Factor) {
+            static_for<Factor>([&](size_t k) { func(i + k); });
         }
-    };
+        for (; i != count; ++i) {
+            func(i);
+        }
+    }
 
-    // partial specialization to terminate recursion
-    template <typename T>
-    class ScalarProduct<1, T> {
+    // fixed length N: completely unrolled up to 'Factor' (default: always),
+    // longer kernels are unrolled in blocks of 'Factor'
+    template <size_t N, size_t Factor = N, typename TFunc>
+    constexpr void fixed_for(TFunc&& func)
+    {
+        if constexpr (N <= Factor) {
+            static_for<N>(func);
+        }
+        else {
+            unrolled_for<Factor>(N, func);
+        }
+    }
+
+    // ScalarProduct<N, T> generalized
+    template <size_t N, size_t Factor = N, typename T>
+    constexpr T dot(const T* a, const T* b)
+    {
+        T product{};
+        fixed_for<N, Factor>([&](size_t i) { product += a[i] * b[i]; });
+        return product;
+    }
+
+    // y = alpha * x + y
+    template <size_t N, size_t Factor = N, typename T>
+    constexpr void axpy(T alpha, const T* x, T* y)
+    {
+        fixed_for<N, Factor>([&](size_t i) { y[i] += alpha * x[i]; });
+    }
+
+    template <size_t N, size_t Factor = N, typename T>
+    constexpr T maximum(const T* x)
+    {
+        T result{ x[0] };
+        fixed_for<N, Factor>([&](size_t i) { result = std::max(result, x[i]); });
+        return result;
+    }
+
+    // the recursive class template, now a thin wrapper of dot<N>
+    template <size_t N, typename T>
+    class ScalarProduct {
     public:
         static inline T result(
             const typename std::vector<T>::const_iterator a,
             const typename std::vector<T>::const_iterator b) {
-                return (*a) * (*b);
+                return dot<N>(std::to_address(a), std::to_address(b));
         }
     };
 
@@ -76,6 +457,53 @@ namespace Exercises_ExpressionTemplates {
             a.cbegin(), 
             a.cbegin()) << std::endl; // 55
     }
+
+    static void test_04()
+    {
+        std::vector<double> a(10'000'000), b(a.size());
+        for (size_t i{}; i != a.size(); ++i) {
+            a[i] = static_cast<double>(i % 7) * 0.5;
+            b[i] = static_cast<double>(i % 5) * 0.25;
+        }
+
+        auto measure = [](const char* name, auto func) {
+            auto start = std::chrono::steady_clock::now();
+            double product{ func() };
+            auto end = std::chrono::steady_clock::now();
+            std::cout << name << ": " << product << " - "
+                << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                << " microseconds." << std::endl;
+        };
+
+        measure("single accumulator ", [&] {
+            double product{};
+            for (size_t i{}; i != a.size(); ++i) {
+                product += a[i] * b[i];
+            }
+            return product;
+        });
+        measure("scalarProduct      ", [&] { return scalarProduct<double>(a, b); });
+        measure("parallel, 1 thread ", [&] { return scalarProductParallel<double>(a, b, 1); });
+        measure("parallel, 4 threads", [&] { return scalarProductParallel<double>(a, b, 4); });   // same value
+    }
+
+    static void test_05()
+    {
+        std::array<double, 5> a{ 1, 2, 3, 4,  5 };
+        std::array<double, 5> b{ 6, 7, 8, 9, 10 };
+        std::cout << "dot<5>(a, b) = " << dot<5>(a.data(), b.data()) << std::endl;            // 130
+
+        axpy<5>(2.0, a.data(), b.data());
+        std::cout << "maximum<5>(b) = " << maximum<5>(b.data()) << std::endl;                 // 20
+
+        // 1003 elements: 125 blocks of 8, 3 remaining iterations
+        std::vector<double> x(1003, 1.0), y(1003, 2.0);
+        std::cout << "dot<1003, 8>(x, y) = " << dot<1003, 8>(x.data(), y.data()) << std::endl;  // 2006
+
+        // evaluated at compile time
+        constexpr std::array<int, 4> v{ 1, 2, 3, 4 };
+        static_assert(dot<4>(v.data(), v.data()) == 30);
+    }
 }
 
 void test_exercices_expression_templates()
@@ -84,6 +512,8 @@ void test_exercices_expression_templates()
     test_01();
     test_02();
     test_03();
+    test_04();
+    test_05();
 }
 
 // =====================================================================================
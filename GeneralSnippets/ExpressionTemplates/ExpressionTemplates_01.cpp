@@ -13,105 +13,594 @@ namespace ExpressionTemplates {
     // default sizes
     constexpr size_t DefaultSize{ 5 };
 
-    // benchmark sizes
+    // benchmark sizes - the benchmark loops consume their results in a checksum,
+    // otherwise the compiler removes the loop altogether
     constexpr int Iterations{ 500000 };
     constexpr size_t BenchmarkSize{ 50 };
 
     // actual sizes
     constexpr size_t Size{ DefaultSize };    // <== modify values here
 
-    template<size_t N, typename T = ElemType>
+    // matrices up to this size are traversed without any loop
+    constexpr size_t UnrollLimit{ 4 };
+
+    // calls func(0), ..., func(Count - 1) as one fold expression: the loop
+    // vanishes at compile time, each call sees a constant argument
+    template <size_t Count, typename TFunc>
+    constexpr void unrolled(TFunc func) {
+        [&] <size_t... I> (std::index_sequence<I...>) {
+            (func(I), ...);
+        } (std::make_index_sequence<Count>{});
+    }
+
+    // ========================================================================
+    // memory layout policies: 'index' maps (x, y) onto the storage,
+    // 'traverse' visits all positions in storage order (unit-stride),
+    // small matrices (N <= UnrollLimit) fully unrolled
+
+    // x selects the row, the elements of a row (y) are contiguous
+    struct RowMajor
+    {
+        template <size_t N>
+        static constexpr size_t StorageSize{ N * N };
+
+        template <size_t N>
+        static constexpr size_t index(size_t x, size_t y) { return x * N + y; }
+
+        template <size_t N, typename TFunc>
+        static constexpr void traverse(TFunc func) {
+            if constexpr (N <= UnrollLimit) {
+                unrolled<N * N>([&](size_t k) { func(k / N, k % N); });
+            }
+            else {
+                for (size_t x{}; x != N; ++x) {
+                    for (size_t y{}; y != N; ++y) {
+                        func(x, y);
+                    }
+                }
+            }
+        }
+    };
+
+    // y selects the column, the elements of a column (x) are contiguous
+    struct ColumnMajor
+    {
+        template <size_t N>
+        static constexpr size_t StorageSize{ N * N };
+
+        template <size_t N>
+        static constexpr size_t index(size_t x, size_t y) { return y * N + x; }
+
+        template <size_t N, typename TFunc>
+        static constexpr void traverse(TFunc func) {
+            if constexpr (N <= UnrollLimit) {
+                unrolled<N * N>([&](size_t k) { func(k % N, k / N); });
+            }
+            else {
+                for (size_t y{}; y != N; ++y) {
+                    for (size_t x{}; x != N; ++x) {
+                        func(x, y);
+                    }
+                }
+            }
+        }
+    };
+
+    // B x B tiles stored one after another, each of them row-major
+    // (the storage is padded, if N is not a multiple of B)
+    template <size_t B = 8>
+    struct Blocked
+    {
+        template <size_t N>
+        static constexpr size_t Tiles{ (N + B - 1) / B };
+
+        template <size_t N>
+        static constexpr size_t StorageSize{ Tiles<N> * Tiles<N> * B * B };
+
+        template <size_t N>
+        static constexpr size_t index(size_t x, size_t y) {
+            return ((x / B) * Tiles<N> + y / B) * B * B + (x % B) * B + y % B;
+        }
+
+        template <size_t N, typename TFunc>
+        static constexpr void traverse(TFunc func) {
+            if constexpr (N <= UnrollLimit && N <= B) {
+                // one single tile
+                unrolled<N * N>([&](size_t k) { func(k / N, k % N); });
+            }
+            else {
+                for (size_t tx{}; tx < N; tx += B) {
+                    for (size_t ty{}; ty < N; ty += B) {
+                        for (size_t x{ tx }; x != std::min(tx + B, N); ++x) {
+                            for (size_t y{ ty }; y != std::min(ty + B, N); ++y) {
+                                func(x, y);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // ========================================================================
+
+    template<size_t N, typename T = ElemType, typename TLayout = RowMajor>
     class Matrix 
     {
     private:
-        std::array<std::array<T, N>, N> m_values;
+        std::array<T, TLayout::template StorageSize<N>> m_values;
 
     public:
+        using value_type = T;
+        using layout_type = TLayout;
+
         // c'tor(s)
-        Matrix() : Matrix{ T{} } {}
-
-        Matrix(T preset) {
-            std::for_each(
-                std::begin(m_values),
-                std::end(m_values),
-                [=](auto& row) {
-                    row.fill(preset);
-                }
-            );
+        constexpr Matrix() : Matrix{ T{} } {}
+
+        constexpr Matrix(T preset) {
+            m_values.fill(preset);
         }
 
         // getter
-        size_t inline getSize() const { return N; };
+        constexpr size_t getSize() const { return N; };
 
         // functor - representing index operator
-        const T& operator()(size_t x, size_t y) const {
-            return m_values[x][y];
+        constexpr const T& operator()(size_t x, size_t y) const {
+            return m_values[TLayout::template index<N>(x, y)];
         };
 
-        T& operator()(size_t x, size_t y) {
-            return m_values[x][y];
+        constexpr T& operator()(size_t x, size_t y) {
+            return m_values[TLayout::template index<N>(x, y)];
         }
 
         // operator+ --> classical implementation
-        Matrix<N> operator+(const Matrix<N>& other) const
+        constexpr Matrix operator+(const Matrix& other) const
         {
-            Matrix<N> result;
-            for (size_t y{}; y != N; ++y) {
-                for (size_t x{}; x != N; ++x) {
-                    result.m_values[x][y] = m_values[x][y] + other.m_values[x][y];
-                }
-            }
+            Matrix result;
+            TLayout::template traverse<N>([&](size_t x, size_t y) {
+                result(x, y) = (*this)(x, y) + other(x, y);
+            });
             return result;
         }
 
         // operator= --> expression template approach
         template <typename TExpr>
-        Matrix<N>& operator=(const TExpr& expr)
+        constexpr Matrix& operator=(const TExpr& expr)
         {
-            for (size_t y{}; y != N; ++y) {
-                for (size_t x{}; x != N; ++x) {
-                    m_values[x][y] = expr(x, y);
-                }
-            }
+            TLayout::template traverse<N>([&](size_t x, size_t y) {
+                (*this)(x, y) = expr(x, y);
+            });
             return *this;
         }
 
         // just for demonstration purposes
-        static Matrix<N> add3(const Matrix<N>& a, const Matrix<N>& b, const Matrix<N>& c)
+        static constexpr Matrix add3(const Matrix& a, const Matrix& b, const Matrix& c)
         {
-            Matrix<N> result;
-
-            for (size_t y{}; y != a.getSize(); ++y) {
-                for (size_t x{}; x != a.getSize(); ++x) {
-                    result.m_values[x][y] = a.m_values[x][y] + b.m_values[x][y] + c.m_values[x][y];
-                }
-            }
+            Matrix result;
+            TLayout::template traverse<N>([&](size_t x, size_t y) {
+                result(x, y) = a(x, y) + b(x, y) + c(x, y);
+            });
             return result;
         }
     };
 
     // ========================================================================
 
-    template <typename TLhs, typename TRhs, typename T = ElemType>
+    // any type which can be evaluated element-wise is a matrix expression
+    template <typename TExpr>
+    concept MatrixExpression = requires (const TExpr& expr, size_t x, size_t y) {
+        typename TExpr::value_type;
+        expr(x, y);
+    };
+
+    // matrices are referenced, all other (lightweight) nodes are stored by value
+    template <typename TExpr>
+    constexpr bool StoreByReference{ false };
+
+    template <size_t N, typename T, typename TLayout>
+    constexpr bool StoreByReference<Matrix<N, T, TLayout>>{ true };
+
+    template <typename TExpr>
+    using ExprStorage = std::conditional_t<StoreByReference<TExpr>, const TExpr&, const TExpr>;
+
+    // mixed element types: a floating-point type wins over an integral one,
+    // otherwise the wider type wins (float + int => float, float + double => double)
+    template <typename T1, typename T2>
+    using Promoted = std::conditional_t<
+        std::is_floating_point_v<T1> != std::is_floating_point_v<T2>,
+        std::conditional_t<std::is_floating_point_v<T1>, T1, T2>,
+        std::conditional_t<(sizeof(T1) >= sizeof(T2)), T1, T2>
+    >;
+
+    // unary operations not available in <functional>
+    struct Abs
+    {
+        template <typename T>
+        T operator()(T value) const { return std::abs(value); }
+    };
+
+    struct Sqrt
+    {
+        template <typename T>
+        T operator()(T value) const { return std::sqrt(value); }
+    };
+
+    struct Exp
+    {
+        template <typename T>
+        T operator()(T value) const { return std::exp(value); }
+    };
+
+    // ========================================================================
+
+    // scalar leaf - the same value at every position
+    template <typename T = ElemType>
+    class Scalar
+    {
+    private:
+        T m_value;
+
+    public:
+        using value_type = T;
+
+        constexpr Scalar(T value) : m_value{ value } {}
+
+        constexpr T operator() (size_t, size_t) const {
+            return m_value;
+        }
+    };
+
+    template <typename TLhs, typename TRhs, typename TOp = std::plus<>,
+        typename T = Promoted<typename TLhs::value_type, typename TRhs::value_type>>
     class MatrixExpr
     {
     private:
-        const TLhs& m_lhs;
-        const TRhs& m_rhs;
+        ExprStorage<TLhs> m_lhs;
+        ExprStorage<TRhs> m_rhs;
+
+    public:
+        using value_type = T;
+
+        constexpr MatrixExpr(const TLhs& lhs, const TRhs& rhs) : m_rhs{ rhs }, m_lhs{ lhs } {}
+
+        constexpr T operator() (size_t x, size_t y) const {
+            return TOp{}(m_lhs(x, y), m_rhs(x, y));
+        }
+    };
+
+    template <typename TExpr, typename TOp, typename T = typename TExpr::value_type>
+    class MatrixUnaryExpr
+    {
+    private:
+        ExprStorage<TExpr> m_expr;
 
     public:
-        MatrixExpr(const TLhs& lhs, const TRhs& rhs) : m_rhs{ rhs }, m_lhs{ lhs } {}
+        using value_type = T;
+
+        constexpr MatrixUnaryExpr(const TExpr& expr) : m_expr{ expr } {}
 
-        T operator() (size_t x, size_t y) const {
-            return m_lhs(x, y) + m_rhs(x, y);
+        constexpr T operator() (size_t x, size_t y) const {
+            return TOp{}(m_expr(x, y));
         }
     };
 
-    template <typename TLhs, typename TRhs>
-    MatrixExpr<TLhs, TRhs> operator+(const TLhs& lhs, const TRhs& rhs) {
+    template <MatrixExpression TLhs, MatrixExpression TRhs>
+    constexpr MatrixExpr<TLhs, TRhs> operator+(const TLhs& lhs, const TRhs& rhs) {
         return MatrixExpr<TLhs, TRhs>(lhs, rhs);
     }
 
+    template <MatrixExpression TLhs, MatrixExpression TRhs>
+    constexpr MatrixExpr<TLhs, TRhs, std::minus<>> operator-(const TLhs& lhs, const TRhs& rhs) {
+        return MatrixExpr<TLhs, TRhs, std::minus<>>(lhs, rhs);
+    }
+
+    // element-wise (Hadamard) product
+    template <MatrixExpression TLhs, MatrixExpression TRhs>
+    constexpr MatrixExpr<TLhs, TRhs, std::multiplies<>> hadamard(const TLhs& lhs, const TRhs& rhs) {
+        return MatrixExpr<TLhs, TRhs, std::multiplies<>>(lhs, rhs);
+    }
+
+    // a scalar takes the element type of the expression it is combined with
+    template <MatrixExpression TExpr>
+    using ScalarOf = Scalar<typename TExpr::value_type>;
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixExpr<ScalarOf<TExpr>, TExpr, std::multiplies<>> operator*(typename TExpr::value_type scalar, const TExpr& expr) {
+        return MatrixExpr<ScalarOf<TExpr>, TExpr, std::multiplies<>>(ScalarOf<TExpr>{ scalar }, expr);
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixExpr<TExpr, ScalarOf<TExpr>, std::multiplies<>> operator*(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixExpr<TExpr, ScalarOf<TExpr>, std::multiplies<>>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixExpr<TExpr, ScalarOf<TExpr>, std::divides<>> operator/(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixExpr<TExpr, ScalarOf<TExpr>, std::divides<>>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixUnaryExpr<TExpr, std::negate<>> operator-(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, std::negate<>>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixUnaryExpr<TExpr, Abs> abs(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Abs>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixUnaryExpr<TExpr, Sqrt> sqrt(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Sqrt>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    constexpr MatrixUnaryExpr<TExpr, Exp> exp(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Exp>(expr);
+    }
+
+    // ========================================================================
+    // single small matrices: product and determinant (N <= 4, closed formulas)
+
+    template <size_t N, typename T, typename TLayout>
+    constexpr Matrix<N, T, TLayout> multiply(const Matrix<N, T, TLayout>& a, const Matrix<N, T, TLayout>& b)
+    {
+        Matrix<N, T, TLayout> result;
+        TLayout::template traverse<N>([&](size_t x, size_t y) {
+            T sum{};
+            for (size_t k{}; k != N; ++k) {
+                sum += a(x, k) * b(k, y);
+            }
+            result(x, y) = sum;
+        });
+        return result;
+    }
+
+    // 'at(x, y)' yields the elements - of one matrix or of one matrix of a batch;
+    // 4 x 4: Laplace expansion along the 2 x 2 minors of the rows 0, 1 and 2, 3
+    template <size_t N, typename TAt>
+    constexpr auto determinantOf(TAt at)
+    {
+        static_assert(N >= 1 && N <= 4, "determinant: closed formulas up to 4 x 4 only");
+
+        if constexpr (N == 1) {
+            return at(0, 0);
+        }
+        else if constexpr (N == 2) {
+            return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
+        }
+        else if constexpr (N == 3) {
+            return at(0, 0) * (at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1))
+                 - at(0, 1) * (at(1, 0) * at(2, 2) - at(1, 2) * at(2, 0))
+                 + at(0, 2) * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0));
+        }
+        else {
+            const auto s0 = at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
+            const auto s1 = at(0, 0) * at(1, 2) - at(0, 2) * at(1, 0);
+            const auto s2 = at(0, 0) * at(1, 3) - at(0, 3) * at(1, 0);
+            const auto s3 = at(0, 1) * at(1, 2) - at(0, 2) * at(1, 1);
+            const auto s4 = at(0, 1) * at(1, 3) - at(0, 3) * at(1, 1);
+            const auto s5 = at(0, 2) * at(1, 3) - at(0, 3) * at(1, 2);
+
+            const auto c0 = at(2, 0) * at(3, 1) - at(2, 1) * at(3, 0);
+            const auto c1 = at(2, 0) * at(3, 2) - at(2, 2) * at(3, 0);
+            const auto c2 = at(2, 0) * at(3, 3) - at(2, 3) * at(3, 0);
+            const auto c3 = at(2, 1) * at(3, 2) - at(2, 2) * at(3, 1);
+            const auto c4 = at(2, 1) * at(3, 3) - at(2, 3) * at(3, 1);
+            const auto c5 = at(2, 2) * at(3, 3) - at(2, 3) * at(3, 2);
+
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+    }
+
+    template <size_t N, typename T, typename TLayout>
+    constexpr T determinant(const Matrix<N, T, TLayout>& matrix)
+    {
+        return determinantOf<N>([&](size_t x, size_t y) { return matrix(x, y); });
+    }
+
+    // ========================================================================
+    // batches of small matrices, structure of arrays (SoA): element (x, y) of
+    // all matrices is stored contiguously. The operations work on blocks of
+    // BatchLanes matrices: loops of constant trip count over the lanes,
+    // writing to local arrays - the compiler vectorizes them, each SIMD lane
+    // works on a different matrix
+
+    // lanes per block: a multiple of the SIMD width (16 doubles fill four AVX registers)
+    constexpr size_t BatchLanes{ 16 };
+
+    template <size_t N, typename T = ElemType>
+    class MatrixBatch
+    {
+    private:
+        size_t m_count;
+        size_t m_stride;            // 'm_count' rounded up to whole blocks (padded with zeros)
+        std::vector<T> m_values;    // N * N arrays of 'm_stride' entries each
+
+    public:
+        using value_type = T;
+
+        // c'tor(s)
+        explicit MatrixBatch(size_t count)
+            : m_count{ count }, m_stride{ (count + BatchLanes - 1) / BatchLanes * BatchLanes }, m_values(N * N * m_stride) {}
+
+        template <typename TLayout>
+        MatrixBatch(size_t count, const Matrix<N, T, TLayout>& preset) : MatrixBatch{ count }
+        {
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{}; y != N; ++y) {
+                    std::fill(lanes(x, y), lanes(x, y) + m_count, preset(x, y));
+                }
+            }
+        }
+
+        // getter
+        constexpr size_t getSize() const { return N; }
+        size_t getCount() const { return m_count; }
+        size_t getStride() const { return m_stride; }
+
+        // element (x, y) of all matrices
+        T* lanes(size_t x, size_t y) { return m_values.data() + (x * N + y) * m_stride; }
+        const T* lanes(size_t x, size_t y) const { return m_values.data() + (x * N + y) * m_stride; }
+
+        // single matrices are gathered and scattered element by element
+        Matrix<N, T> get(size_t k) const
+        {
+            Matrix<N, T> matrix;
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{}; y != N; ++y) {
+                    matrix(x, y) = lanes(x, y)[k];
+                }
+            }
+            return matrix;
+        }
+
+        template <typename TLayout>
+        void set(size_t k, const Matrix<N, T, TLayout>& matrix)
+        {
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{}; y != N; ++y) {
+                    lanes(x, y)[k] = matrix(x, y);
+                }
+            }
+        }
+    };
+
+    // the elements of all matrices of a batch, in row-major order
+    template <size_t N, typename T>
+    std::array<const T*, N * N> lanesOf(const MatrixBatch<N, T>& batch)
+    {
+        std::array<const T*, N * N> lanes;
+        for (size_t e{}; e != N * N; ++e) {
+            lanes[e] = batch.lanes(e / N, e % N);
+        }
+        return lanes;
+    }
+
+    // all batches of an operation hold the same number of matrices
+    template <size_t N, typename T, typename... TBatches>
+    void checkCounts(const MatrixBatch<N, T>& batch, const TBatches&... others)
+    {
+        if (((others.getCount() != batch.getCount()) || ...)) {
+            throw std::invalid_argument("MatrixBatch: batches differ in count");
+        }
+    }
+
+    // a block is computed completely before it is stored: the result may be
+    // one of the operands
+    template <size_t N, typename T>
+    void storeBlock(const T (&block)[N * N][BatchLanes], MatrixBatch<N, T>& result, size_t first)
+    {
+        for (size_t e{}; e != N * N; ++e) {
+            std::copy_n(block[e], BatchLanes, result.lanes(e / N, e % N) + first);
+        }
+    }
+
+    template <size_t N, typename T>
+    void add(const MatrixBatch<N, T>& a, const MatrixBatch<N, T>& b, MatrixBatch<N, T>& result)
+    {
+        checkCounts(a, b, result);
+
+        const auto lhs{ lanesOf(a) };
+        const auto rhs{ lanesOf(b) };
+
+        for (size_t first{}; first != a.getStride(); first += BatchLanes) {
+            T sum[N * N][BatchLanes];
+            for (size_t e{}; e != N * N; ++e) {
+                for (size_t w{}; w != BatchLanes; ++w) {
+                    sum[e][w] = lhs[e][first + w] + rhs[e][first + w];
+                }
+            }
+            storeBlock<N>(sum, result, first);
+        }
+    }
+
+    template <size_t N, typename T>
+    void multiply(const MatrixBatch<N, T>& a, const MatrixBatch<N, T>& b, MatrixBatch<N, T>& result)
+    {
+        checkCounts(a, b, result);
+
+        const auto lhs{ lanesOf(a) };
+        const auto rhs{ lanesOf(b) };
+
+        for (size_t first{}; first != a.getStride(); first += BatchLanes) {
+            T product[N * N][BatchLanes];
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{}; y != N; ++y) {
+                    for (size_t w{}; w != BatchLanes; ++w) {
+                        T sum{};
+                        unrolled<N>([&](size_t k) { sum += lhs[x * N + k][first + w] * rhs[k * N + y][first + w]; });
+                        product[x * N + y][w] = sum;
+                    }
+                }
+            }
+            storeBlock<N>(product, result, first);
+        }
+    }
+
+    // transposing a batch moves whole arrays - in place, they are swapped
+    template <size_t N, typename T>
+    void transpose(const MatrixBatch<N, T>& a, MatrixBatch<N, T>& result)
+    {
+        checkCounts(a, result);
+
+        if (&a == &result) {
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{ x + 1 }; y != N; ++y) {
+                    std::swap_ranges(result.lanes(x, y), result.lanes(x, y) + a.getStride(), result.lanes(y, x));
+                }
+            }
+            return;
+        }
+
+        for (size_t x{}; x != N; ++x) {
+            for (size_t y{}; y != N; ++y) {
+                std::copy_n(a.lanes(y, x), a.getStride(), result.lanes(x, y));
+            }
+        }
+    }
+
+    // 'result' holds (at least) one entry per matrix; 4 x 4: the expansion of
+    // 'determinantOf', the 2 x 2 minors are computed first - one short loop each
+    template <size_t N, typename T>
+    void determinant(const MatrixBatch<N, T>& a, std::span<T> result)
+    {
+        if (result.size() < a.getCount()) {
+            throw std::invalid_argument("MatrixBatch: too few entries for the determinants");
+        }
+
+        const auto lanes{ lanesOf(a) };
+
+        for (size_t first{}; first < a.getCount(); first += BatchLanes) {
+            T det[BatchLanes];
+            if constexpr (N == 4) {
+                // column pairs of the minors: s0, ..., s5 (rows 0, 1) and c0, ..., c5 (rows 2, 3)
+                constexpr size_t Pairs[6][2]{ { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+
+                T s[6][BatchLanes];
+                T c[6][BatchLanes];
+                for (size_t p{}; p != 6; ++p) {
+                    const size_t i{ Pairs[p][0] };
+                    const size_t j{ Pairs[p][1] };
+                    for (size_t w{}; w != BatchLanes; ++w) {
+                        s[p][w] = lanes[i][first + w] * lanes[4 + j][first + w] - lanes[j][first + w] * lanes[4 + i][first + w];
+                        c[p][w] = lanes[8 + i][first + w] * lanes[12 + j][first + w] - lanes[8 + j][first + w] * lanes[12 + i][first + w];
+                    }
+                }
+                for (size_t w{}; w != BatchLanes; ++w) {
+                    det[w] = s[0][w] * c[5][w] - s[1][w] * c[4][w] + s[2][w] * c[3][w]
+                           + s[3][w] * c[2][w] - s[4][w] * c[1][w] + s[5][w] * c[0][w];
+                }
+            }
+            else {
+                for (size_t w{}; w != BatchLanes; ++w) {
+                    det[w] = determinantOf<N>([&](size_t x, size_t y) { return lanes[x * N + y][first + w]; });
+                }
+            }
+            std::copy_n(det, std::min(BatchLanes, a.getCount() - first), result.begin() + first);
+        }
+    }
+
     // ========================================================================
 
     static void test_00()
@@ -209,6 +698,43 @@ namespace ExpressionTemplates {
         result = sumABCD;
     }
 
+    static void test_05()
+    {
+        std::cout << "Expression Template 05: Fused Operator Algebra" << std::endl;
+
+        Matrix<Size> a{ 5.0 }, b{ 1.0 }, c{ 3.0 }, d{ 16.0 };
+        Matrix<Size> result{};
+
+        // one single pass, no temporary Matrix objects
+        result = 0.5 * hadamard(a - b, c) + sqrt(d);   // result(x, y) = 10
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;
+
+        result = -abs(b - a) / 2.0 + exp(b - b);        // result(x, y) = -1
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;
+    }
+
+    // evaluated at compile time: all loops of a 3 x 3 matrix are unrolled
+    constexpr Matrix<3> scaledSum()
+    {
+        Matrix<3> a{ 1.0 }, b{ 2.0 }, result{};
+        result = a + 2.0 * b - hadamard(a, b);
+        return result;
+    }
+
+    static void test_07()
+    {
+        std::cout << "Expression Template 07: Small Matrices (constexpr)" << std::endl;
+
+        constexpr Matrix<3> result{ scaledSum() };
+        static_assert(result(2, 1) == 3.0);
+
+        constexpr Matrix<4, int, ColumnMajor> sum{ Matrix<4, int, ColumnMajor>::add3(1, 2, 3) };
+        static_assert(sum(3, 3) == 6);
+
+        std::cout << "result(2, 1) = " << result(2, 1) << std::endl;   // 3
+        std::cout << "sum(3, 3)    = " << sum(3, 3) << std::endl;      // 6
+    }
+
     // =====================================================================================
 
     static void test_04a_benchmark(
@@ -275,6 +801,233 @@ namespace ExpressionTemplates {
         test_04b_benchmark(Iterations, result, a, b, c, d, e);
         std::cout << "Done." << std::endl;
     }
+    // =====================================================================================
+
+    // evaluates 'result = a1 + a2 + a3 + a4 + a5' with both loop orders:
+    // following the layout of the matrices and against it
+    template <typename TLayout>
+    static void test_06_benchmark_layout(const char* name)
+    {
+        using LayoutMatrix = Matrix<BenchmarkSize, ElemType, TLayout>;
+
+        LayoutMatrix a1{ 1.0 }, a2{ 2.0 }, a3{ 3.0 }, a4{ 4.0 }, a5{ 5.0 };
+        LayoutMatrix result{};
+
+        MatrixExpr sumAB{ a1, a2 };
+        MatrixExpr sumABC{ sumAB, a3 };
+        MatrixExpr sumABCD{ sumABC, a4 };
+        MatrixExpr sum{ sumABCD, a5 };
+
+        ElemType checksum{};
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i{}; i != Iterations; ++i) {
+            a1(i % BenchmarkSize, 0) = static_cast<ElemType>(i);
+            result = sum;
+            checksum += result(BenchmarkSize - 1, i % BenchmarkSize);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << name << " (unit-stride): "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " milliseconds." << std::endl;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i{}; i != Iterations; ++i) {
+            a1(i % BenchmarkSize, 0) = static_cast<ElemType>(i);
+            for (size_t y{}; y != BenchmarkSize; ++y) {
+                for (size_t x{}; x != BenchmarkSize; ++x) {
+                    result(x, y) = sum(x, y);
+                }
+            }
+            checksum += result(BenchmarkSize - 1, i % BenchmarkSize);
+        }
+        end = std::chrono::high_resolution_clock::now();
+
+        std::cout << name << " (y outer, x inner): "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " milliseconds." << std::endl;
+
+        std::cout << "checksum: " << checksum << std::endl;
+    }
+
+    static void test_06_benchmark()
+    {
+        std::cout << "Expression Templates 06 (Benchmark Memory Layouts):" << std::endl;
+
+        test_06_benchmark_layout<RowMajor>("RowMajor");
+        test_06_benchmark_layout<ColumnMajor>("ColumnMajor");
+        test_06_benchmark_layout<Blocked<>>("Blocked");
+    }
+
+    // =====================================================================================
+
+    // 'result = a + b + c' on an N x N matrix: unrolled assignment vs. nested loops
+    template <size_t N>
+    static void test_07_benchmark_size()
+    {
+        constexpr size_t SmallIterations{ 20 * Iterations };
+
+        Matrix<N> a{ 1.0 }, b{ 2.0 }, c{ 3.0 };
+        Matrix<N> result{};
+
+        MatrixExpr sumAB{ a, b };
+        MatrixExpr sum{ sumAB, c };
+
+        ElemType checksum{};
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i{}; i != SmallIterations; ++i) {
+            a(i % N, 0) = static_cast<ElemType>(i);
+            result = sum;
+            checksum += result(N - 1, i % N);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << N << 'x' << N << " (unrolled): "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " milliseconds." << std::endl;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i{}; i != SmallIterations; ++i) {
+            a(i % N, 0) = static_cast<ElemType>(i);
+            for (size_t x{}; x != N; ++x) {
+                for (size_t y{}; y != N; ++y) {
+                    result(x, y) = sum(x, y);
+                }
+            }
+            checksum += result(N - 1, i % N);
+        }
+        end = std::chrono::high_resolution_clock::now();
+
+        std::cout << N << 'x' << N << " (loops):    "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " milliseconds." << std::endl;
+
+        std::cout << "checksum: " << checksum << std::endl;
+    }
+
+    static void test_07_benchmark()
+    {
+        std::cout << "Expression Templates 07 (Benchmark Small Matrices):" << std::endl;
+
+        test_07_benchmark_size<2>();
+        test_07_benchmark_size<3>();
+        test_07_benchmark_size<4>();
+    }
+
+    // =====================================================================================
+
+    static void test_08()
+    {
+        std::cout << "Expression Template 08: Batches of Small Matrices" << std::endl;
+
+        // a shear (determinant 1) and a scaling (determinant 24)
+        constexpr Matrix<3> shear{ [] { Matrix<3> m{}; m(0, 0) = m(1, 1) = m(2, 2) = 1.0; m(0, 2) = 5.0; return m; }() };
+        static_assert(determinant(shear) == 1.0);
+
+        Matrix<3> scaling{};
+        scaling(0, 0) = 2.0;
+        scaling(1, 1) = 3.0;
+        scaling(2, 2) = 4.0;
+
+        constexpr size_t Count{ 1001 };     // not a multiple of BatchLanes
+
+        MatrixBatch<3> a{ Count, shear }, b{ Count, scaling }, c{ Count };
+        a.lanes(0, 1)[Count - 1] = 7.0;     // one matrix differs
+
+        multiply(a, b, c);
+        std::cout << "c(0, 2) = " << c.get(0)(0, 2) << std::endl;                     // 20
+        std::cout << "c(0, 1) = " << c.get(Count - 1)(0, 1) << std::endl;             // 21
+
+        std::vector<double> det(Count);
+        determinant(c, std::span<double>{ det });
+        std::cout << "det(c) = " << det[0] << ", " << det[Count - 1] << std::endl;    // 24, 24
+
+        transpose(c, c);
+        add(c, c, c);
+        std::cout << "c(2, 0) = " << c.get(0)(2, 0) << std::endl;                     // 40
+
+        // batches of different counts are rejected
+        try {
+            MatrixBatch<3> small{ 10 };
+            add(c, c, small);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;                                         // MatrixBatch: batches differ in count
+        }
+
+        // 4 x 4: the batch agrees with the single matrix
+        Matrix<4> m{};
+        for (size_t x{}; x != 4; ++x) {
+            for (size_t y{}; y != 4; ++y) {
+                m(x, y) = static_cast<double>((x * 5 + y * 3) % 7) - 3.0;
+            }
+        }
+
+        MatrixBatch<4> d{ 3, m };
+        std::vector<double> det4(3);
+        determinant(d, std::span<double>{ det4 });
+        std::cout << "det(m) = " << determinant(m) << ", " << det4[2] << std::endl;  // equal
+    }
+
+    // 'c = a * b' and 'det(a)' for many N x N matrices: array of structures
+    // (one Matrix after the other) vs. structure of arrays (MatrixBatch)
+    template <size_t N>
+    static void test_08_benchmark_size(size_t count)
+    {
+        constexpr int Repetitions{ 20 };
+
+        Matrix<N> m{};
+        for (size_t x{}; x != N; ++x) {
+            for (size_t y{}; y != N; ++y) {
+                m(x, y) = static_cast<ElemType>((x + 2 * y) % 5) + ((x == y) ? 3.0 : 0.0);
+            }
+        }
+
+        std::vector<Matrix<N>> a(count, m), b(count, m), c(count);
+        MatrixBatch<N> sa{ count, m }, sb{ count, m }, sc{ count };
+        std::vector<ElemType> det(count);
+
+        ElemType checksum{};
+
+        auto measure = [&](const char* name, auto func) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i{}; i != Repetitions; ++i) {
+                func();
+                checksum += det[i % count] + c[i % count](0, 0) + sc.lanes(0, 0)[i % count];
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << N << 'x' << N << ' ' << name
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                << " milliseconds." << std::endl;
+        };
+
+        measure("multiply AoS:      ", [&] {
+            for (size_t k{}; k != count; ++k) {
+                c[k] = multiply(a[k], b[k]);
+            }
+        });
+        measure("multiply batch:    ", [&] { multiply(sa, sb, sc); });
+
+        measure("determinant AoS:   ", [&] {
+            for (size_t k{}; k != count; ++k) {
+                det[k] = determinant(a[k]);
+            }
+        });
+        measure("determinant batch: ", [&] { determinant(sa, std::span<ElemType>{ det }); });
+
+        std::cout << "checksum: " << checksum << std::endl;
+    }
+
+    static void test_08_benchmark()
+    {
+        std::cout << "Expression Templates 08 (Benchmark Batches of Small Matrices):" << std::endl;
+
+        test_08_benchmark_size<3>(200000);
+        test_08_benchmark_size<4>(200000);
+    }
 }
 
 void main_expression_templates()
@@ -284,6 +1037,12 @@ void main_expression_templates()
     test_02();            // <== expression templates approach
     test_03();            // <== expression templates approach using modified operator=
     test_04_benchmark();  // <== benchmark
+    test_05();            // <== subtraction, scaling, Hadamard product and unary functions
+    test_06_benchmark();  // <== benchmark memory layouts
+    test_07();            // <== small matrices, evaluated at compile time
+    test_07_benchmark();  // <== benchmark small matrices: unrolled vs. loops
+    test_08();            // <== batches of small matrices (structure of arrays)
+    test_08_benchmark();  // <== benchmark batches: structure of arrays vs. array of structures
 }
 
 // =====================================================================================
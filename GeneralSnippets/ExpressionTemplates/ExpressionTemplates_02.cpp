@@ -2,12 +2,39 @@
 // ExpressionTemplates_02.cpp // Expression Templates
 // =====================================================================================
 
+module;
+
+// AVX2 packets need '/arch:AVX2' (MSVC, set for x64 in GeneralSnippets.vcxproj)
+// or '-mavx2 -mfma' (gcc, clang) - otherwise SSE2 packets are used
+#if defined(__AVX2__)
+#define ET_SIMD_AVX2
+#include <immintrin.h>   // AVX2 intrinsics
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ET_SIMD_SSE2
+#include <emmintrin.h>   // SSE2 intrinsics
+#endif
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>     // file mappings
+#else
+#include <fcntl.h>       // memory-mapped files
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 module modern_cpp:expression_templates;
 
 namespace ExpressionTemplates_VectorBasedVersion {
 
     constexpr bool Verbose{ false };
 
+    // records cost and time of each 'Matrix = expression' (see Instrumentation) -
+    // if false, no instrumentation code is compiled at all
+    constexpr bool Instrumented{ false };
+
     // default sizes
     constexpr size_t DefaultCols{ 3 };
     constexpr size_t DefaultRows{ 3 };
@@ -17,290 +44,5005 @@ namespace ExpressionTemplates_VectorBasedVersion {
     constexpr size_t BenchmarkRows { 1000 };
     constexpr size_t BenchmarkCols { 1000 };
 
-    // actual sizes
-    constexpr size_t Cols{ BenchmarkRows };  // <== modify values here
-    constexpr size_t Rows{ BenchmarkRows };  // <== modify values here
+    // actual sizes
+    constexpr size_t Cols{ BenchmarkRows };  // <== modify values here
+    constexpr size_t Rows{ BenchmarkRows };  // <== modify values here
+
+    // parallel evaluation: expressions with fewer elements are evaluated sequentially
+    constexpr size_t ParallelThreshold{ 256 * 1024 };
+
+    // size of a tile (a range of complete rows) handed over to one worker
+    constexpr size_t TileBytes{ 64 * 1024 };
+
+    // alignment of the matrix storage
+    constexpr size_t CacheLine{ 64 };
+
+    // out-of-core matrices are evaluated in chunks of this size, the pages of
+    // a finished chunk are released - this bounds the resident memory
+    constexpr size_t StreamingBytes{ 8 * 1024 * 1024 };
+
+    // shared subexpressions are cached in blocks of this size (per thread, L1-resident)
+    constexpr size_t SharedBlockBytes{ 8 * 1024 };
+
+    // row strides which are a multiple of this size map the elements of one column
+    // onto the same cache set and let loads and stores alias (4K aliasing)
+    constexpr size_t AliasingBytes{ 4096 };
+
+    // ========================================================================
+    // SIMD support: a 'Packet' bundles as many elements as fit into one
+    // SIMD register, the primary template is the scalar fallback (1 lane)
+
+    template <typename T>
+    struct Packet
+    {
+        static constexpr size_t Lanes{ 1 };
+
+        T m_reg;
+
+        // 'Aligned': the address is a multiple of the packet size
+        static Packet load(const T* src) { return { *src }; }
+        static Packet loadAligned(const T* src) { return { *src }; }
+        static Packet broadcast(T value) { return { value }; }
+        void store(T* dst) const { *dst = m_reg; }
+        void storeAligned(T* dst) const { *dst = m_reg; }
+
+        // note: arithmetic on small integer types yields 'int', hence the casts
+        friend Packet operator+(Packet a, Packet b) { return { static_cast<T>(a.m_reg + b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { static_cast<T>(a.m_reg - b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { static_cast<T>(a.m_reg * b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return { static_cast<T>(a.m_reg / b.m_reg) }; }
+        friend Packet operator-(Packet a) { return { static_cast<T>(-a.m_reg) }; }
+
+        // a * b + c
+        friend Packet fma(Packet a, Packet b, Packet c) { return { static_cast<T>(a.m_reg * b.m_reg + c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return { static_cast<T>(std::abs(a.m_reg)) }; }
+        friend Packet sqrt(Packet a) { return { static_cast<T>(std::sqrt(a.m_reg)) }; }
+        friend Packet exp(Packet a) { return { static_cast<T>(std::exp(a.m_reg)) }; }
+
+        friend Packet min(Packet a, Packet b) { return { std::min(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { std::max(a.m_reg, b.m_reg) }; }
+
+        // comparisons yield a mask per lane (here: 1 or 0, SIMD: all bits set or none),
+        // 'select' blends two packets with it - 'mask ? a : b' without a branch
+        friend Packet cmpLess(Packet a, Packet b) { return { static_cast<T>(a.m_reg < b.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { static_cast<T>(a.m_reg <= b.m_reg) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { static_cast<T>(a.m_reg == b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { static_cast<T>(a.m_reg != b.m_reg) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return mask.m_reg != T{} ? a : b; }
+    };
+
+    // applies a scalar function to each lane (for operations without SIMD instruction)
+    template <typename T, typename TFunc>
+    Packet<T> forEachLane(Packet<T> packet, TFunc func)
+    {
+        T lanes[Packet<T>::Lanes];
+        packet.store(lanes);
+        for (auto& lane : lanes) {
+            lane = static_cast<T>(func(lane));
+        }
+        return Packet<T>::load(lanes);
+    }
+
+    template <typename T, typename TFunc>
+    Packet<T> forEachLane(Packet<T> a, Packet<T> b, TFunc func)
+    {
+        T lhs[Packet<T>::Lanes];
+        T rhs[Packet<T>::Lanes];
+        a.store(lhs);
+        b.store(rhs);
+        for (size_t k{}; k != Packet<T>::Lanes; ++k) {
+            lhs[k] = static_cast<T>(func(lhs[k], rhs[k]));
+        }
+        return Packet<T>::load(lhs);
+    }
+
+#if defined(ET_SIMD_AVX2)
+
+    template <>
+    struct Packet<double>
+    {
+        static constexpr size_t Lanes{ 4 };
+
+        __m256d m_reg;
+
+        static Packet load(const double* src) { return { _mm256_loadu_pd(src) }; }
+        static Packet loadAligned(const double* src) { return { _mm256_load_pd(src) }; }
+        static Packet broadcast(double value) { return { _mm256_set1_pd(value) }; }
+        void store(double* dst) const { _mm256_storeu_pd(dst, m_reg); }
+        void storeAligned(double* dst) const { _mm256_store_pd(dst, m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm256_add_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm256_sub_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm256_mul_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return { _mm256_div_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a) { return { _mm256_xor_pd(a.m_reg, _mm256_set1_pd(-0.0)) }; }
+
+#if defined(__FMA__) || defined(_MSC_VER)
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_fmadd_pd(a.m_reg, b.m_reg, c.m_reg) }; }
+#else
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_add_pd(_mm256_mul_pd(a.m_reg, b.m_reg), c.m_reg) }; }
+#endif
+
+        friend Packet abs(Packet a) { return { _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return { _mm256_sqrt_pd(a.m_reg) }; }
+        friend Packet exp(Packet a) { return forEachLane(a, [](double value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm256_min_pd(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm256_max_pd(a.m_reg, b.m_reg) }; }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_LT_OQ) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_LE_OQ) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_EQ_OQ) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_NEQ_UQ) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm256_blendv_pd(b.m_reg, a.m_reg, mask.m_reg) }; }
+    };
+
+    // float: twice the lanes of double in the same register
+    template <>
+    struct Packet<float>
+    {
+        static constexpr size_t Lanes{ 8 };
+
+        __m256 m_reg;
+
+        static Packet load(const float* src) { return { _mm256_loadu_ps(src) }; }
+        static Packet loadAligned(const float* src) { return { _mm256_load_ps(src) }; }
+        static Packet broadcast(float value) { return { _mm256_set1_ps(value) }; }
+        void store(float* dst) const { _mm256_storeu_ps(dst, m_reg); }
+        void storeAligned(float* dst) const { _mm256_store_ps(dst, m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm256_add_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm256_sub_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm256_mul_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return { _mm256_div_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a) { return { _mm256_xor_ps(a.m_reg, _mm256_set1_ps(-0.0f)) }; }
+
+#if defined(__FMA__) || defined(_MSC_VER)
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_fmadd_ps(a.m_reg, b.m_reg, c.m_reg) }; }
+#else
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_add_ps(_mm256_mul_ps(a.m_reg, b.m_reg), c.m_reg) }; }
+#endif
+
+        friend Packet abs(Packet a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return { _mm256_sqrt_ps(a.m_reg) }; }
+        friend Packet exp(Packet a) { return forEachLane(a, [](float value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm256_min_ps(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm256_max_ps(a.m_reg, b.m_reg) }; }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm256_cmp_ps(a.m_reg, b.m_reg, _CMP_LT_OQ) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm256_cmp_ps(a.m_reg, b.m_reg, _CMP_LE_OQ) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm256_cmp_ps(a.m_reg, b.m_reg, _CMP_EQ_OQ) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm256_cmp_ps(a.m_reg, b.m_reg, _CMP_NEQ_UQ) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm256_blendv_ps(b.m_reg, a.m_reg, mask.m_reg) }; }
+    };
+
+    // 32-bit integers: there is no SIMD integer division, it is done lane by lane
+    template <>
+    struct Packet<std::int32_t>
+    {
+        static constexpr size_t Lanes{ 8 };
+
+        __m256i m_reg;
+
+        static Packet load(const std::int32_t* src) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)) }; }
+        static Packet loadAligned(const std::int32_t* src) { return { _mm256_load_si256(reinterpret_cast<const __m256i*>(src)) }; }
+        static Packet broadcast(std::int32_t value) { return { _mm256_set1_epi32(value) }; }
+        void store(std::int32_t* dst) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), m_reg); }
+        void storeAligned(std::int32_t* dst) const { _mm256_store_si256(reinterpret_cast<__m256i*>(dst), m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm256_add_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm256_sub_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm256_mullo_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return forEachLane(a, b, [](std::int32_t l, std::int32_t r) { return l / r; }); }
+        friend Packet operator-(Packet a) { return { _mm256_sub_epi32(_mm256_setzero_si256(), a.m_reg) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_add_epi32(_mm256_mullo_epi32(a.m_reg, b.m_reg), c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return { _mm256_abs_epi32(a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return forEachLane(a, [](std::int32_t value) { return std::sqrt(value); }); }
+        friend Packet exp(Packet a) { return forEachLane(a, [](std::int32_t value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm256_min_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm256_max_epi32(a.m_reg, b.m_reg) }; }
+
+        // integers only compare for 'greater' and 'equal', the other masks are their complement
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm256_cmpgt_epi32(b.m_reg, a.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm256_xor_si256(_mm256_cmpgt_epi32(a.m_reg, b.m_reg), _mm256_set1_epi32(-1)) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm256_cmpeq_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm256_xor_si256(_mm256_cmpeq_epi32(a.m_reg, b.m_reg), _mm256_set1_epi32(-1)) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm256_blendv_epi8(b.m_reg, a.m_reg, mask.m_reg) }; }
+    };
+
+    // 16-bit integers: four times the lanes of double in the same register
+    template <>
+    struct Packet<std::int16_t>
+    {
+        static constexpr size_t Lanes{ 16 };
+
+        __m256i m_reg;
+
+        static Packet load(const std::int16_t* src) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)) }; }
+        static Packet loadAligned(const std::int16_t* src) { return { _mm256_load_si256(reinterpret_cast<const __m256i*>(src)) }; }
+        static Packet broadcast(std::int16_t value) { return { _mm256_set1_epi16(value) }; }
+        void store(std::int16_t* dst) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), m_reg); }
+        void storeAligned(std::int16_t* dst) const { _mm256_store_si256(reinterpret_cast<__m256i*>(dst), m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm256_add_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm256_sub_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm256_mullo_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return forEachLane(a, b, [](std::int16_t l, std::int16_t r) { return l / r; }); }
+        friend Packet operator-(Packet a) { return { _mm256_sub_epi16(_mm256_setzero_si256(), a.m_reg) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm256_add_epi16(_mm256_mullo_epi16(a.m_reg, b.m_reg), c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return { _mm256_abs_epi16(a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return forEachLane(a, [](std::int16_t value) { return std::sqrt(value); }); }
+        friend Packet exp(Packet a) { return forEachLane(a, [](std::int16_t value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm256_min_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm256_max_epi16(a.m_reg, b.m_reg) }; }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm256_cmpgt_epi16(b.m_reg, a.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm256_xor_si256(_mm256_cmpgt_epi16(a.m_reg, b.m_reg), _mm256_set1_epi32(-1)) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm256_cmpeq_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm256_xor_si256(_mm256_cmpeq_epi16(a.m_reg, b.m_reg), _mm256_set1_epi32(-1)) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm256_blendv_epi8(b.m_reg, a.m_reg, mask.m_reg) }; }
+    };
+
+#elif defined(ET_SIMD_SSE2)
+
+    template <>
+    struct Packet<double>
+    {
+        static constexpr size_t Lanes{ 2 };
+
+        __m128d m_reg;
+
+        static Packet load(const double* src) { return { _mm_loadu_pd(src) }; }
+        static Packet loadAligned(const double* src) { return { _mm_load_pd(src) }; }
+        static Packet broadcast(double value) { return { _mm_set1_pd(value) }; }
+        void store(double* dst) const { _mm_storeu_pd(dst, m_reg); }
+        void storeAligned(double* dst) const { _mm_store_pd(dst, m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm_add_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm_sub_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm_mul_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return { _mm_div_pd(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a) { return { _mm_xor_pd(a.m_reg, _mm_set1_pd(-0.0)) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm_add_pd(_mm_mul_pd(a.m_reg, b.m_reg), c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return { _mm_andnot_pd(_mm_set1_pd(-0.0), a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return { _mm_sqrt_pd(a.m_reg) }; }
+        friend Packet exp(Packet a) { return forEachLane(a, [](double value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm_min_pd(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm_max_pd(a.m_reg, b.m_reg) }; }
+
+        // SSE2 has no blend instruction (SSE4.1) - 'a & mask | b & ~mask' instead
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm_cmplt_pd(a.m_reg, b.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm_cmple_pd(a.m_reg, b.m_reg) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm_cmpeq_pd(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm_cmpneq_pd(a.m_reg, b.m_reg) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm_or_pd(_mm_and_pd(mask.m_reg, a.m_reg), _mm_andnot_pd(mask.m_reg, b.m_reg)) }; }
+    };
+
+    template <>
+    struct Packet<float>
+    {
+        static constexpr size_t Lanes{ 4 };
+
+        __m128 m_reg;
+
+        static Packet load(const float* src) { return { _mm_loadu_ps(src) }; }
+        static Packet loadAligned(const float* src) { return { _mm_load_ps(src) }; }
+        static Packet broadcast(float value) { return { _mm_set1_ps(value) }; }
+        void store(float* dst) const { _mm_storeu_ps(dst, m_reg); }
+        void storeAligned(float* dst) const { _mm_store_ps(dst, m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm_add_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm_sub_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm_mul_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return { _mm_div_ps(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a) { return { _mm_xor_ps(a.m_reg, _mm_set1_ps(-0.0f)) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm_add_ps(_mm_mul_ps(a.m_reg, b.m_reg), c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.m_reg) }; }
+        friend Packet sqrt(Packet a) { return { _mm_sqrt_ps(a.m_reg) }; }
+        friend Packet exp(Packet a) { return forEachLane(a, [](float value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm_min_ps(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm_max_ps(a.m_reg, b.m_reg) }; }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm_cmplt_ps(a.m_reg, b.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm_cmple_ps(a.m_reg, b.m_reg) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm_cmpeq_ps(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm_cmpneq_ps(a.m_reg, b.m_reg) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm_or_ps(_mm_and_ps(mask.m_reg, a.m_reg), _mm_andnot_ps(mask.m_reg, b.m_reg)) }; }
+    };
+
+    // SSE2 lacks 32-bit multiplication, abs, min and max (SSE4.1 / SSSE3) - done lane by lane
+    template <>
+    struct Packet<std::int32_t>
+    {
+        static constexpr size_t Lanes{ 4 };
+
+        __m128i m_reg;
+
+        static Packet load(const std::int32_t* src) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)) }; }
+        static Packet loadAligned(const std::int32_t* src) { return { _mm_load_si128(reinterpret_cast<const __m128i*>(src)) }; }
+        static Packet broadcast(std::int32_t value) { return { _mm_set1_epi32(value) }; }
+        void store(std::int32_t* dst) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), m_reg); }
+        void storeAligned(std::int32_t* dst) const { _mm_store_si128(reinterpret_cast<__m128i*>(dst), m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm_add_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm_sub_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return forEachLane(a, b, [](std::int32_t l, std::int32_t r) { return l * r; }); }
+        friend Packet operator/(Packet a, Packet b) { return forEachLane(a, b, [](std::int32_t l, std::int32_t r) { return l / r; }); }
+        friend Packet operator-(Packet a) { return { _mm_sub_epi32(_mm_setzero_si128(), a.m_reg) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return a * b + c; }
+
+        friend Packet abs(Packet a) { return forEachLane(a, [](std::int32_t value) { return std::abs(value); }); }
+        friend Packet sqrt(Packet a) { return forEachLane(a, [](std::int32_t value) { return std::sqrt(value); }); }
+        friend Packet exp(Packet a) { return forEachLane(a, [](std::int32_t value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return forEachLane(a, b, [](std::int32_t l, std::int32_t r) { return std::min(l, r); }); }
+        friend Packet max(Packet a, Packet b) { return forEachLane(a, b, [](std::int32_t l, std::int32_t r) { return std::max(l, r); }); }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm_cmplt_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm_xor_si128(_mm_cmpgt_epi32(a.m_reg, b.m_reg), _mm_set1_epi32(-1)) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm_cmpeq_epi32(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm_xor_si128(_mm_cmpeq_epi32(a.m_reg, b.m_reg), _mm_set1_epi32(-1)) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm_or_si128(_mm_and_si128(mask.m_reg, a.m_reg), _mm_andnot_si128(mask.m_reg, b.m_reg)) }; }
+    };
+
+    template <>
+    struct Packet<std::int16_t>
+    {
+        static constexpr size_t Lanes{ 8 };
+
+        __m128i m_reg;
+
+        static Packet load(const std::int16_t* src) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)) }; }
+        static Packet loadAligned(const std::int16_t* src) { return { _mm_load_si128(reinterpret_cast<const __m128i*>(src)) }; }
+        static Packet broadcast(std::int16_t value) { return { _mm_set1_epi16(value) }; }
+        void store(std::int16_t* dst) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), m_reg); }
+        void storeAligned(std::int16_t* dst) const { _mm_store_si128(reinterpret_cast<__m128i*>(dst), m_reg); }
+
+        friend Packet operator+(Packet a, Packet b) { return { _mm_add_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator-(Packet a, Packet b) { return { _mm_sub_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator*(Packet a, Packet b) { return { _mm_mullo_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet operator/(Packet a, Packet b) { return forEachLane(a, b, [](std::int16_t l, std::int16_t r) { return l / r; }); }
+        friend Packet operator-(Packet a) { return { _mm_sub_epi16(_mm_setzero_si128(), a.m_reg) }; }
+        friend Packet fma(Packet a, Packet b, Packet c) { return { _mm_add_epi16(_mm_mullo_epi16(a.m_reg, b.m_reg), c.m_reg) }; }
+
+        friend Packet abs(Packet a) { return forEachLane(a, [](std::int16_t value) { return std::abs(value); }); }
+        friend Packet sqrt(Packet a) { return forEachLane(a, [](std::int16_t value) { return std::sqrt(value); }); }
+        friend Packet exp(Packet a) { return forEachLane(a, [](std::int16_t value) { return std::exp(value); }); }
+
+        friend Packet min(Packet a, Packet b) { return { _mm_min_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet max(Packet a, Packet b) { return { _mm_max_epi16(a.m_reg, b.m_reg) }; }
+
+        friend Packet cmpLess(Packet a, Packet b) { return { _mm_cmplt_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet cmpLessEqual(Packet a, Packet b) { return { _mm_xor_si128(_mm_cmpgt_epi16(a.m_reg, b.m_reg), _mm_set1_epi32(-1)) }; }
+        friend Packet cmpEqual(Packet a, Packet b) { return { _mm_cmpeq_epi16(a.m_reg, b.m_reg) }; }
+        friend Packet cmpNotEqual(Packet a, Packet b) { return { _mm_xor_si128(_mm_cmpeq_epi16(a.m_reg, b.m_reg), _mm_set1_epi32(-1)) }; }
+        friend Packet select(Packet mask, Packet a, Packet b) { return { _mm_or_si128(_mm_and_si128(mask.m_reg, a.m_reg), _mm_andnot_si128(mask.m_reg, b.m_reg)) }; }
+    };
+
+#endif
+
+    // assembles a packet lane by lane (for elements not stored contiguously)
+    template <typename T, typename TFunc>
+    Packet<T> makePacket(TFunc func)
+    {
+        T lanes[Packet<T>::Lanes];
+        for (size_t k{}; k != Packet<T>::Lanes; ++k) {
+            lanes[k] = func(k);
+        }
+        return Packet<T>::load(lanes);
+    }
+
+    // ========================================================================
+    // element types: expressions mixing element types are evaluated in the
+    // promoted type - a floating-point type wins over an integral one,
+    // otherwise the wider type wins (float + int32_t => float,
+    // int16_t + int32_t => int32_t, float + double => double)
+
+    template <typename T1, typename T2>
+    using Promoted = std::conditional_t<
+        std::is_floating_point_v<T1> != std::is_floating_point_v<T2>,
+        std::conditional_t<std::is_floating_point_v<T1>, T1, T2>,
+        std::conditional_t<(sizeof(T1) >= sizeof(T2)), T1, T2>
+    >;
+
+    // SIMD batch of an expression, converted to 'T' lane by lane if its element type differs
+    template <typename T, typename TExpr>
+    Packet<T> evalAs(const TExpr& expr, size_t i)
+    {
+        if constexpr (std::is_same_v<typename TExpr::value_type, T>) {
+            return expr.eval(i);
+        }
+        else {
+            return makePacket<T>([&](size_t k) { return static_cast<T>(expr[i + k]); });
+        }
+    }
+
+    // same as above - the packet of the expression starts at an aligned address
+    template <typename T, typename TExpr>
+    Packet<T> evalAlignedAs(const TExpr& expr, size_t i)
+    {
+        if constexpr (std::is_same_v<typename TExpr::value_type, T>) {
+            return expr.evalAligned(i);
+        }
+        else {
+            return makePacket<T>([&](size_t k) { return static_cast<T>(expr[i + k]); });
+        }
+    }
+
+    template <typename T, typename TExpr>
+    Packet<T> evalAs(const TExpr& expr, size_t x, size_t y)
+    {
+        if constexpr (std::is_same_v<typename TExpr::value_type, T>) {
+            return expr.eval(x, y);
+        }
+        else {
+            return makePacket<T>([&](size_t k) { return static_cast<T>(expr(x + k, y)); });
+        }
+    }
+
+    // ========================================================================
+    // operations of the expression nodes - each of them works on single
+    // elements as well as on packets
+
+    struct Plus
+    {
+        static constexpr const char* Name{ "+" };
+        template <typename V> V operator()(V a, V b) const { return a + b; }
+    };
+
+    struct Minus
+    {
+        static constexpr const char* Name{ "-" };
+        template <typename V> V operator()(V a, V b) const { return a - b; }
+    };
+
+    struct Multiplies
+    {
+        static constexpr const char* Name{ "*" };
+        template <typename V> V operator()(V a, V b) const { return a * b; }
+    };
+
+    struct Divides
+    {
+        static constexpr const char* Name{ "/" };
+        template <typename V> V operator()(V a, V b) const { return a / b; }
+    };
+
+    struct Negate
+    {
+        static constexpr const char* Name{ "-" };
+        template <typename V> V operator()(V a) const { return -a; }
+    };
+
+    struct Abs
+    {
+        static constexpr const char* Name{ "abs" };
+        template <typename V> V operator()(V a) const { using std::abs; return abs(a); }
+    };
+
+    struct Sqrt
+    {
+        static constexpr const char* Name{ "sqrt" };
+        template <typename V> V operator()(V a) const { using std::sqrt; return sqrt(a); }
+    };
+
+    struct Exp
+    {
+        static constexpr const char* Name{ "exp" };
+        template <typename V> V operator()(V a) const { using std::exp; return exp(a); }
+    };
+
+    struct Min
+    {
+        static constexpr const char* Name{ "min" };
+        template <typename V> V operator()(V a, V b) const { using std::min; return min(a, b); }
+    };
+
+    struct Max
+    {
+        static constexpr const char* Name{ "max" };
+        template <typename V> V operator()(V a, V b) const { using std::max; return max(a, b); }
+    };
+
+    // comparisons: a 'bool' for single elements, a mask for packets
+    struct Less
+    {
+        static constexpr const char* Name{ "<" };
+        template <typename V> bool operator()(V a, V b) const { return a < b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpLess(a, b); }
+    };
+
+    struct LessEqual
+    {
+        static constexpr const char* Name{ "<=" };
+        template <typename V> bool operator()(V a, V b) const { return a <= b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpLessEqual(a, b); }
+    };
+
+    struct Greater
+    {
+        static constexpr const char* Name{ ">" };
+        template <typename V> bool operator()(V a, V b) const { return a > b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpLess(b, a); }
+    };
+
+    struct GreaterEqual
+    {
+        static constexpr const char* Name{ ">=" };
+        template <typename V> bool operator()(V a, V b) const { return a >= b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpLessEqual(b, a); }
+    };
+
+    struct Equal
+    {
+        static constexpr const char* Name{ "==" };
+        template <typename V> bool operator()(V a, V b) const { return a == b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpEqual(a, b); }
+    };
+
+    struct NotEqual
+    {
+        static constexpr const char* Name{ "!=" };
+        template <typename V> bool operator()(V a, V b) const { return a != b; }
+        template <typename T> Packet<T> operator()(Packet<T> a, Packet<T> b) const { return cmpNotEqual(a, b); }
+    };
+
+    // ========================================================================
+    // reusable pool of worker threads - the calling thread takes part
+    // in the work, too, so 'hardware_concurrency() - 1' workers are started
+
+    class WorkerPool
+    {
+    private:
+        std::vector<std::jthread> m_workers;
+        std::mutex m_mutex;
+        std::mutex m_callMutex;
+        std::condition_variable_any m_cvWork;
+        std::condition_variable m_cvDone;
+
+        const std::function<void(size_t)>* m_task;
+        std::atomic<size_t> m_next;
+        size_t m_count;
+        size_t m_pending;
+        size_t m_generation;
+        std::exception_ptr m_error;   // first exception thrown by a task
+
+    public:
+        // c'tor(s) / d'tor
+        WorkerPool() : WorkerPool{ std::max(std::thread::hardware_concurrency(), 1u) - 1 } {}
+
+        WorkerPool(size_t workers)
+            : m_task{}, m_next{}, m_count{}, m_pending{}, m_generation{}
+        {
+            for (size_t i{}; i != workers; ++i) {
+                m_workers.emplace_back([this](std::stop_token token) { run(token); });
+            }
+        }
+
+        ~WorkerPool()
+        {
+            for (auto& worker : m_workers) {
+                worker.request_stop();
+            }
+            m_cvWork.notify_all();
+
+            // join before the mutexes and condition variables are destroyed
+            m_workers.clear();
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        static WorkerPool& instance()
+        {
+            static WorkerPool pool{};
+            return pool;
+        }
+
+        // getter
+        size_t concurrency() const { return m_workers.size() + 1; }
+
+        // invokes task(0), ..., task(count - 1) and returns when all of them are done
+        // (must not be called from inside a task) - if a task throws, the remaining
+        // indices are skipped and the first exception is rethrown on the calling thread
+        void parallelFor(size_t count, const std::function<void(size_t)>& task)
+        {
+            std::lock_guard<std::mutex> call{ m_callMutex };
+
+            {
+                std::lock_guard<std::mutex> guard{ m_mutex };
+                m_task = &task;
+                m_count = count;
+                m_next = 0;
+                m_pending = m_workers.size();
+                m_error = nullptr;
+                ++m_generation;
+            }
+            m_cvWork.notify_all();
+
+            work();
+
+            std::unique_lock<std::mutex> guard{ m_mutex };
+            m_cvDone.wait(guard, [this] () { return m_pending == 0; });
+            m_task = nullptr;
+
+            if (m_error) {
+                std::rethrow_exception(std::exchange(m_error, nullptr));
+            }
+        }
+
+    private:
+        void run(std::stop_token token)
+        {
+            size_t generation{};
+
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> guard{ m_mutex };
+                    if (!m_cvWork.wait(guard, token, [&] () { return m_generation != generation; })) {
+                        return;  // stop requested
+                    }
+                    generation = m_generation;
+                }
+
+                work();
+
+                {
+                    std::lock_guard<std::mutex> guard{ m_mutex };
+                    --m_pending;
+                }
+                m_cvDone.notify_one();
+            }
+        }
+
+        void work()
+        {
+            try {
+                for (size_t index{ m_next++ }; index < m_count; index = m_next++) {
+                    (*m_task)(index);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard{ m_mutex };
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+                m_next = m_count;
+            }
+        }
+    };
+
+    // number of complete rows forming one tile of TileBytes
+    template <typename T>
+    size_t rowsPerTile(size_t cols)
+    {
+        return std::max<size_t>(TileBytes / (cols * sizeof(T)), 1);
+    }
+
+    // shared subexpressions (see 'shared') are cached per thread: each evaluated tile
+    // opens a new scope - cache contents of an older scope are never reused, and no
+    // cache is filled beyond the tile (other threads may be writing there)
+    struct CacheScope
+    {
+        size_t m_generation;
+        size_t m_end;     // linear index behind the tile
+        size_t m_cols;    // column behind the tile
+
+        static CacheScope& current()
+        {
+            thread_local CacheScope scope{};
+            return scope;
+        }
+
+        static void open(size_t end, size_t cols)
+        {
+            CacheScope& scope{ current() };
+            ++scope.m_generation;
+            scope.m_end = end;
+            scope.m_cols = cols;
+        }
+    };
+
+    // ========================================================================
+    // instrumentation (see Instrumented): each 'Matrix = expression' is recorded
+    // with its cost - estimated from the expression tree - and its elapsed time
+
+    // cost of one element of an expression, summed up over its nodes
+    struct ExprCost
+    {
+        size_t m_nodes;
+        double m_flops;
+        double m_bytesRead;
+    };
+
+    struct AssignmentReport
+    {
+        size_t m_nodes;
+        size_t m_elements;
+        double m_flops;
+        double m_bytesRead;
+        double m_bytesWritten;
+        double m_seconds;
+
+        // 0 for assignments below the clock resolution
+        double gigabytesPerSecond() const { return (m_seconds == 0.0) ? 0.0 : (m_bytesRead + m_bytesWritten) / m_seconds * 1e-9; }
+        double gigaflopsPerSecond() const { return (m_seconds == 0.0) ? 0.0 : m_flops / m_seconds * 1e-9; }
+    };
+
+    class Instrumentation
+    {
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<AssignmentReport> m_reports;
+        std::chrono::steady_clock::duration m_dumpInterval;
+        std::chrono::steady_clock::time_point m_lastDump;
+
+    public:
+        static Instrumentation& instance()
+        {
+            static Instrumentation instrumentation{};
+            return instrumentation;
+        }
+
+        template <typename TExpr>
+        void record(const TExpr& expr, size_t elements, size_t elementSize, std::chrono::steady_clock::duration elapsed)
+        {
+            ExprCost cost{};
+            expr.addCost(cost);
+
+            const AssignmentReport report{
+                cost.m_nodes,
+                elements,
+                cost.m_flops * static_cast<double>(elements),
+                cost.m_bytesRead * static_cast<double>(elements),
+                static_cast<double>(elementSize * elements),
+                std::chrono::duration<double>{ elapsed }.count()
+            };
+
+            std::lock_guard guard{ m_mutex };
+            m_reports.push_back(report);
+
+            // periodic dump: all reports since the last one
+            const auto now{ std::chrono::steady_clock::now() };
+            if (m_dumpInterval != std::chrono::steady_clock::duration::zero() && now - m_lastDump >= m_dumpInterval) {
+                dump(std::cout, m_reports);
+                m_reports.clear();
+                m_lastDump = now;
+            }
+        }
+
+        // query API
+        std::vector<AssignmentReport> reports() const
+        {
+            std::lock_guard guard{ m_mutex };
+            return m_reports;
+        }
+
+        void clear()
+        {
+            std::lock_guard guard{ m_mutex };
+            m_reports.clear();
+        }
+
+        void dump(std::ostream& os) const
+        {
+            std::lock_guard guard{ m_mutex };
+            dump(os, m_reports);
+        }
+
+        // zero: no periodic dump
+        void setDumpInterval(std::chrono::steady_clock::duration interval)
+        {
+            std::lock_guard guard{ m_mutex };
+            m_dumpInterval = interval;
+            m_lastDump = std::chrono::steady_clock::now();
+        }
+
+    private:
+        Instrumentation() : m_dumpInterval{}, m_lastDump{ std::chrono::steady_clock::now() } {}
+
+        static void dump(std::ostream& os, const std::vector<AssignmentReport>& reports)
+        {
+            for (const auto& report : reports) {
+                os << "assignment: " << report.m_nodes << " nodes, "
+                    << report.m_elements << " elements, "
+                    << report.m_flops << " flops, "
+                    << report.m_bytesRead << " bytes read, "
+                    << report.m_bytesWritten << " bytes written, "
+                    << report.m_seconds * 1e6 << " microseconds, "
+                    << report.gigabytesPerSecond() << " GB/s" << std::endl;
+            }
+        }
+    };
+
+    // ========================================================================
+    // storage: aligned to a cache line, rows optionally padded
+
+    template <typename T, size_t Alignment = CacheLine>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+        T* allocate(size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+        }
+
+        void deallocate(T* ptr, size_t) {
+            ::operator delete(ptr, std::align_val_t{ Alignment });
+        }
+
+        friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) { return true; }
+    };
+
+    // 'None': rows are packed, 'CacheLine': each row starts on a cache line,
+    // strides being a multiple of AliasingBytes are extended by one cache line
+    enum class RowPadding { None, CacheLine };
+
+    template <typename T>
+    size_t rowStride(size_t cols, RowPadding padding)
+    {
+        if (padding == RowPadding::None) {
+            return cols;
+        }
+
+        constexpr size_t PerLine{ std::max<size_t>(CacheLine / sizeof(T), 1) };
+
+        size_t stride{ (cols + PerLine - 1) / PerLine * PerLine };
+        if ((stride * sizeof(T)) % AliasingBytes == 0) {
+            stride += PerLine;
+        }
+        return stride;
+    }
+
+    // linear expressions: stride shared by all operands, a scalar (0) adapts to any stride
+    constexpr size_t NoCommonStride{ std::numeric_limits<size_t>::max() };
+
+    inline size_t commonStride(size_t lhs, size_t rhs)
+    {
+        if (lhs == 0 || lhs == rhs) {
+            return rhs;
+        }
+        return (rhs == 0) ? lhs : NoCommonStride;
+    }
+
+    // ========================================================================
+    // out-of-core storage: the elements live in a file, mapped into memory -
+    // interchangeable with 'std::vector' as storage of a Matrix
+
+    // 'ReadOnly': an existing file is mapped as it is, writing to it faults
+    enum class MapMode { ReadWrite, ReadOnly };
+
+    template <typename T>
+    class MappedStorage
+    {
+    private:
+        std::filesystem::path m_path;
+        MapMode m_mode;
+        size_t m_offset;         // position of the first element in the file
+        void* m_view;            // mapping of the whole file
+        size_t m_viewBytes;
+        T* m_data;
+        size_t m_size;
+
+#if defined(_WIN32)
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        int m_file;
+#endif
+
+    public:
+        // c'tor(s) / d'tor - an existing file keeps its contents,
+        // the elements start at 'offset' (a multiple of CacheLine)
+        explicit MappedStorage(std::filesystem::path path, MapMode mode = MapMode::ReadWrite, size_t offset = 0)
+            : m_path{ std::move(path) }, m_mode{ mode }, m_offset{ offset },
+              m_view{}, m_viewBytes{}, m_data{}, m_size{}
+        {
+            const bool writable{ mode == MapMode::ReadWrite };
+#if defined(_WIN32)
+            m_mapping = nullptr;
+            m_file = ::CreateFileW(m_path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                writable ? 0 : FILE_SHARE_READ, nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) {
+                throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "CreateFile");
+            }
+#else
+            m_file = writable ? ::open(m_path.c_str(), O_RDWR | O_CREAT, 0644) : ::open(m_path.c_str(), O_RDONLY);
+            if (m_file == -1) {
+                throw std::system_error(errno, std::generic_category(), "open");
+            }
+#endif
+        }
+
+        ~MappedStorage()
+        {
+            unmap();
+#if defined(_WIN32)
+            if (m_file != INVALID_HANDLE_VALUE) {
+                ::CloseHandle(m_file);
+            }
+#else
+            if (m_file != -1) {
+                ::close(m_file);
+            }
+#endif
+        }
+
+        MappedStorage(MappedStorage&& other) noexcept
+            : m_path{ std::move(other.m_path) }, m_mode{ other.m_mode }, m_offset{ other.m_offset },
+              m_view{ std::exchange(other.m_view, nullptr) }, m_viewBytes{ std::exchange(other.m_viewBytes, 0) },
+              m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) },
+#if defined(_WIN32)
+              m_file{ std::exchange(other.m_file, INVALID_HANDLE_VALUE) },
+              m_mapping{ std::exchange(other.m_mapping, nullptr) }
+#else
+              m_file{ std::exchange(other.m_file, -1) }
+#endif
+        {}
+
+        MappedStorage(const MappedStorage&) = delete;
+        MappedStorage& operator=(const MappedStorage&) = delete;
+        MappedStorage& operator=(MappedStorage&&) = delete;
+
+        // getter
+        size_t size() const { return m_size; }
+        const T* data() const { return m_data; }
+        T* data() { return m_data; }
+        const std::filesystem::path& path() const { return m_path; }
+
+        const T& operator[](size_t i) const { return m_data[i]; }
+        T& operator[](size_t i) { return m_data[i]; }
+
+        T* begin() { return m_data; }
+        T* end() { return m_data + m_size; }
+
+        // maps 'count' elements: a writable file is resized (new elements are zero),
+        // a read-only file must contain them already
+        void resize(size_t count)
+        {
+            unmap();
+
+            const size_t bytes{ m_offset + count * sizeof(T) };
+            if (count == 0) {
+                return;
+            }
+
+#if defined(_WIN32)
+            if (m_mode == MapMode::ReadWrite) {
+                LARGE_INTEGER size{};
+                size.QuadPart = static_cast<LONGLONG>(bytes);
+                if (!::SetFilePointerEx(m_file, size, nullptr, FILE_BEGIN) || !::SetEndOfFile(m_file)) {
+                    throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "SetEndOfFile");
+                }
+            }
+            else {
+                LARGE_INTEGER size{};
+                if (!::GetFileSizeEx(m_file, &size) || static_cast<size_t>(size.QuadPart) < bytes) {
+                    throw std::runtime_error("MappedStorage: file too short");
+                }
+            }
+
+            const bool writable{ m_mode == MapMode::ReadWrite };
+            m_mapping = ::CreateFileMappingW(m_file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+            void* view{ m_mapping ? ::MapViewOfFile(m_mapping, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, bytes) : nullptr };
+            if (view == nullptr) {
+                throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "MapViewOfFile");
+            }
+#else
+            if (m_mode == MapMode::ReadWrite) {
+                if (::ftruncate(m_file, static_cast<off_t>(bytes)) == -1) {
+                    throw std::system_error(errno, std::generic_category(), "ftruncate");
+                }
+            }
+            else {
+                struct stat info {};
+                if (::fstat(m_file, &info) == -1 || static_cast<size_t>(info.st_size) < bytes) {
+                    throw std::runtime_error("MappedStorage: file too short");
+                }
+            }
+
+            const int protection{ m_mode == MapMode::ReadWrite ? PROT_READ | PROT_WRITE : PROT_READ };
+            void* view{ ::mmap(nullptr, bytes, protection, MAP_SHARED, m_file, 0) };
+            if (view == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap");
+            }
+
+            // expression evaluation walks the file front to back
+            ::madvise(view, bytes, MADV_SEQUENTIAL);
+#endif
+            m_view = view;
+            m_viewBytes = bytes;
+            m_data = reinterpret_cast<T*>(static_cast<char*>(view) + m_offset);
+            m_size = count;
+        }
+
+        // drops the pages of the elements [begin, end) from the resident memory -
+        // modified pages are written back to the file, nothing is lost
+        void release(size_t begin, size_t end) const
+        {
+            const size_t page{ pageSize() };
+            const uintptr_t base{ reinterpret_cast<uintptr_t>(m_data) };
+            const uintptr_t first{ (base + begin * sizeof(T) + page - 1) / page * page };
+            const uintptr_t last{ (base + end * sizeof(T)) / page * page };
+
+            if (first < last) {
+#if defined(_WIN32)
+                ::VirtualUnlock(reinterpret_cast<void*>(first), last - first);
+#else
+                ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#endif
+            }
+        }
+
+    private:
+        void unmap()
+        {
+            if (m_view == nullptr) {
+                return;
+            }
+#if defined(_WIN32)
+            ::UnmapViewOfFile(m_view);
+            ::CloseHandle(m_mapping);
+            m_mapping = nullptr;
+#else
+            ::munmap(m_view, m_viewBytes);
+#endif
+            m_view = nullptr;
+            m_viewBytes = 0;
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        static size_t pageSize()
+        {
+#if defined(_WIN32)
+            SYSTEM_INFO info{};
+            ::GetSystemInfo(&info);
+            return info.dwPageSize;
+#else
+            return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+        }
+    };
+
+    // storages able to drop the pages of finished chunks
+    template <typename TStorage>
+    concept ReleasableStorage = requires (const TStorage& storage, size_t begin, size_t end) {
+        storage.release(begin, end);
+    };
+
+    // expressions able to drop the pages of finished rows of their leaves (linear nodes only)
+    template <typename TExpr>
+    concept ReleasableExpression = requires (const TExpr& expr, size_t first, size_t last) {
+        expr.release(first, last);
+    };
+
+    // ========================================================================
+
+    template <typename TAddend>
+    class MatrixProduct;
+
+    template <typename TExpr>
+    class SparseSum;
+
+    class SparseTerm;
+
+    class DeferredEvaluation;
+
+    // element type 'T': double, float, int32_t and int16_t have SIMD kernels,
+    // any other arithmetic type is evaluated by the scalar fallback
+    // storage 'TStorage': aligned std::vector or MappedStorage (out-of-core)
+    template <typename T = double, typename TStorage = std::vector<T, AlignedAllocator<T>>>
+    class Matrix {
+    private:
+        size_t m_cols;
+        size_t m_rows;
+        size_t m_stride;
+        TStorage m_values;
+
+    public:
+        using value_type = T;
+        using storage_type = TStorage;
+
+        // elements can be addressed by one linear index (row after row, 'y * stride + x')
+        static constexpr bool IsLinear{ true };
+
+        // c'tor(s)
+        Matrix() : Matrix(Cols, Rows) {}
+
+        Matrix(size_t cols, size_t rows, RowPadding padding = RowPadding::None)
+            : m_cols{ cols }, m_rows{ rows }, m_stride{ rowStride<T>(cols, padding) }
+        {
+            m_values.resize(m_stride * rows);
+        }
+
+        // storage passed in, e.g. a MappedStorage
+        Matrix(size_t cols, size_t rows, TStorage&& storage, RowPadding padding = RowPadding::None)
+            : m_cols{ cols }, m_rows{ rows }, m_stride{ rowStride<T>(cols, padding) }, m_values{ std::move(storage) }
+        {
+            m_values.resize(m_stride * rows);
+        }
+
+        Matrix(T fill) : Matrix(Cols, Rows)
+        {
+            std::fill(
+                std::begin(m_values),
+                std::end(m_values),
+                fill
+            );
+        }
+
+        // copy and move (declared, since copy assignment is hand-written)
+        Matrix(const Matrix&) = default;
+        Matrix(Matrix&&) = default;
+        Matrix& operator=(Matrix&&) = default;
+
+        // getter
+        size_t inline getCols() const { return m_cols; };
+        size_t inline getRows() const { return m_rows; };
+        size_t inline getStride() const { return m_stride; };
+
+        // functor - representing index operator
+        const T& operator()(size_t x, size_t y) const;
+        T& operator()(size_t x, size_t y);
+
+        // linear access - scalar element and SIMD batch starting at index i
+        T operator[](size_t i) const { return m_values[i]; }
+        Packet<T> eval(size_t i) const { return Packet<T>::load(&m_values[i]); }
+        Packet<T> evalAligned(size_t i) const { return Packet<T>::loadAligned(&m_values[i]); }
+
+        // SIMD batch (x, y) ... (x + Lanes - 1, y) within one row
+        Packet<T> eval(size_t x, size_t y) const { return Packet<T>::load(&m_values[y * m_stride + x]); }
+
+        // storage read by an expression
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const {
+            return static_cast<const void*>(this) == static_cast<const void*>(&matrix);
+        }
+
+        // storage read at positions other than the one being assigned -
+        // a leaf is read element-wise only
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>&) const { return false; }
+
+        // per element: one node, one element read
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; cost.m_bytesRead += sizeof(T); }
+
+        // out-of-core storage: drops the pages of the rows [first, last)
+        void release(size_t first, size_t last) const {
+            if constexpr (ReleasableStorage<TStorage>) {
+                m_values.release(first * m_stride, last * m_stride);
+            }
+        }
+
+        // raw storage (row after row, 'getStride()' elements apart)
+        const T* data() const { return m_values.data(); }
+        T* data() { return m_values.data(); }
+
+        // operator= --> classical definition
+        Matrix& operator=(const Matrix& rhs);
+
+        // operator= --> expression template approach (template member method)
+        template <typename TExpr>
+        Matrix& operator=(const TExpr& expression);
+
+        // operator= --> matrix product, evaluated by a blocked GEMM kernel
+        template <typename TAddend>
+        Matrix& operator=(const MatrixProduct<TAddend>& product);
+
+        // operator= --> dense expression plus sparse terms, scattered afterwards
+        template <typename TExpr>
+        Matrix& operator=(const SparseSum<TExpr>& expr);
+
+        // operator= --> scaled sparse matrix, scattered onto zeros
+        Matrix& operator=(const SparseTerm& term);
+
+    private:
+        friend class DeferredEvaluation;
+
+        template <typename TExpr>
+        void assign(const TExpr& expr);
+
+        template <typename TExpr>
+        void evaluate(const TExpr& expr, size_t first, size_t last);
+
+        template <typename TExpr>
+        void evaluateParallel(const TExpr& expr, size_t first, size_t last);
+
+        template <typename TExpr>
+        void evaluateStreaming(const TExpr& expr);
+    };
+
+    // matrix backed by a memory-mapped file
+    template <typename T = double>
+    using MappedMatrix = Matrix<T, MappedStorage<T>>;
+
+    // ========================================================================
+    // binary matrix files: a header of 64 bytes, followed by the raw elements
+    // (row after row, 'stride' elements apart) - byte order of the writing machine.
+    // The elements start on a cache line, a mapped file is used as it is
+
+    enum class ElementType : uint32_t { Float64 = 1, Float32 = 2, Int32 = 3, Int16 = 4 };
+
+    template <typename T>
+    consteval ElementType elementTypeOf()
+    {
+        if constexpr (std::is_same_v<T, double>)       { return ElementType::Float64; }
+        else if constexpr (std::is_same_v<T, float>)   { return ElementType::Float32; }
+        else if constexpr (std::is_same_v<T, int32_t>) { return ElementType::Int32; }
+        else {
+            static_assert(std::is_same_v<T, int16_t>, "no file format for this element type");
+            return ElementType::Int16;
+        }
+    }
+
+    struct MatrixFileHeader
+    {
+        static constexpr char Magic[8]{ 'E', 'T', 'M', 'A', 'T', 'R', 'I', 'X' };
+        static constexpr uint32_t CurrentVersion{ 1 };
+
+        char magic[8];
+        uint32_t version;
+        ElementType elementType;
+        uint32_t elementSize;
+        uint32_t alignment;
+        uint64_t cols;
+        uint64_t rows;
+        uint64_t stride;
+        uint64_t dataOffset;
+    };
+
+    static_assert(sizeof(MatrixFileHeader) <= CacheLine);
+
+    template <typename T, typename TStorage>
+    void writeMatrix(const std::filesystem::path& path, const Matrix<T, TStorage>& matrix)
+    {
+        MatrixFileHeader header{};
+        std::copy(std::begin(MatrixFileHeader::Magic), std::end(MatrixFileHeader::Magic), header.magic);
+        header.version = MatrixFileHeader::CurrentVersion;
+        header.elementType = elementTypeOf<T>();
+        header.elementSize = sizeof(T);
+        header.alignment = CacheLine;
+        header.cols = matrix.getCols();
+        header.rows = matrix.getRows();
+        header.stride = matrix.getStride();
+        header.dataOffset = CacheLine;
+
+        char block[CacheLine]{};
+        std::memcpy(block, &header, sizeof(header));
+
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        file.write(block, sizeof(block));
+        file.write(reinterpret_cast<const char*>(matrix.data()),
+            static_cast<std::streamsize>(matrix.getStride() * matrix.getRows() * sizeof(T)));
+
+        if (!file) {
+            throw std::runtime_error("writeMatrix: cannot write " + path.string());
+        }
+    }
+
+    template <typename T>
+    MatrixFileHeader readMatrixHeader(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+
+        MatrixFileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            throw std::runtime_error("readMatrixHeader: cannot read " + path.string());
+        }
+
+        if (!std::equal(std::begin(MatrixFileHeader::Magic), std::end(MatrixFileHeader::Magic), header.magic) ||
+            header.version != MatrixFileHeader::CurrentVersion) {
+            throw std::runtime_error("readMatrixHeader: no matrix file " + path.string());
+        }
+
+        if (header.elementType != elementTypeOf<T>() || header.elementSize != sizeof(T)) {
+            throw std::invalid_argument("readMatrixHeader: element type mismatch");
+        }
+
+        if (header.dataOffset % CacheLine != 0 || header.stride < header.cols) {
+            throw std::runtime_error("readMatrixHeader: corrupt header " + path.string());
+        }
+
+        return header;
+    }
+
+    // padding policy reproducing the stride of a file
+    template <typename T>
+    RowPadding paddingOf(const MatrixFileHeader& header)
+    {
+        const size_t cols{ static_cast<size_t>(header.cols) };
+
+        if (header.stride == cols) {
+            return RowPadding::None;
+        }
+        if (header.stride == rowStride<T>(cols, RowPadding::CacheLine)) {
+            return RowPadding::CacheLine;
+        }
+        throw std::invalid_argument("paddingOf: unsupported row stride");
+    }
+
+    // bulk read into an owned, aligned matrix
+    template <typename T = double>
+    Matrix<T> readMatrix(const std::filesystem::path& path)
+    {
+        const MatrixFileHeader header{ readMatrixHeader<T>(path) };
+
+        Matrix<T> matrix{ static_cast<size_t>(header.cols), static_cast<size_t>(header.rows), paddingOf<T>(header) };
+
+        std::ifstream file{ path, std::ios::binary };
+        file.seekg(static_cast<std::streamoff>(header.dataOffset));
+        file.read(reinterpret_cast<char*>(matrix.data()),
+            static_cast<std::streamsize>(matrix.getStride() * matrix.getRows() * sizeof(T)));
+
+        if (!file) {
+            throw std::runtime_error("readMatrix: file too short " + path.string());
+        }
+
+        return matrix;
+    }
+
+    // zero-copy load: the file is mapped read-only, the matrix is a view onto it
+    template <typename T = double>
+    MappedMatrix<T> mapMatrix(const std::filesystem::path& path)
+    {
+        const MatrixFileHeader header{ readMatrixHeader<T>(path) };
+
+        return MappedMatrix<T>{
+            static_cast<size_t>(header.cols),
+            static_cast<size_t>(header.rows),
+            MappedStorage<T>{ path, MapMode::ReadOnly, static_cast<size_t>(header.dataOffset) },
+            paddingOf<T>(header)
+        };
+    }
+
+    template <typename T, typename TStorage>
+    const T& Matrix<T, TStorage>::operator()(size_t x, size_t y) const {
+        //if constexpr (Verbose) {
+        //    std::cout << "Matrix::operator() => [" << x << ',' << y << ']' << std::endl;
+        //}
+        return m_values[y * m_stride + x];
+    }
+
+    template <typename T, typename TStorage>
+    T& Matrix<T, TStorage>::operator()(size_t x, size_t y) {
+        //if constexpr (Verbose) {
+        //    std::cout << "Matrix::operator() => [" << x << ',' << y << ']' << std::endl;
+        //}
+        return m_values[y * m_stride + x];
+    }
+
+    // classical approach, kept for comparison: a plain matrix of doubles whose
+    // operator+ evaluates right away - one temporary per addition. It is no
+    // matrix expression, so 'Matrix + Matrix' builds a MatrixExpr as usual
+    class ClassicalMatrix {
+    private:
+        size_t m_cols;
+        size_t m_rows;
+        std::vector<double> m_values;
+
+    public:
+        // c'tor(s)
+        ClassicalMatrix() : ClassicalMatrix(Cols, Rows) {}
+
+        ClassicalMatrix(size_t cols, size_t rows, double fill = 0.0) : m_cols{ cols }, m_rows{ rows }
+        {
+            m_values.resize(cols * rows, fill);
+        }
+
+        ClassicalMatrix(double fill) : ClassicalMatrix(Cols, Rows, fill) {}
+
+        // getter
+        size_t inline getCols() const { return m_cols; };
+        size_t inline getRows() const { return m_rows; };
+
+        // functor - representing index operator
+        const double& operator()(size_t x, size_t y) const { return m_values[y * m_cols + x]; }
+        double& operator()(size_t x, size_t y) { return m_values[y * m_cols + x]; }
+    };
+
+    // classical operator+ definition
+    ClassicalMatrix operator+(const ClassicalMatrix& lhs, const ClassicalMatrix& rhs)
+    {
+        ClassicalMatrix result{ lhs.getCols(), lhs.getRows() };
+
+        for (size_t y{}; y != lhs.getRows(); ++y) {
+            for (size_t x{}; x != lhs.getCols(); ++x) {
+
+                if constexpr (Verbose) {
+                    double l {lhs(x, y)};
+                    double r {rhs(x, y)};
+                    std::cout << "Matrix:: adding " << l << '+' << r << std::endl;
+                    double tmp{ l + r };
+                    std::cout << "Matrix:: assigning result " << tmp << std::endl;
+                    result(x, y) = tmp;
+                }
+                else {
+                    result(x, y) = lhs(x, y) + rhs(x, y);
+                }
+            }
+        }
+        return result;
+    }
+
+    // classical operator= implementation
+    template <typename T, typename TStorage>
+    Matrix<T, TStorage>& Matrix<T, TStorage>::operator=(const Matrix& rhs) {
+
+        // prevent self-assignment
+        if (this != &rhs) {
+            m_cols = rhs.m_cols;
+            m_rows = rhs.m_rows;
+            m_stride = rhs.m_stride;
+            m_values = rhs.m_values;
+        }
+
+        return *this;
+    }
+
+    // expression template approach: operator=
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    Matrix<T, TStorage>& Matrix<T, TStorage>::operator=(const TExpr& expr) {
+
+        // the expression reads this matrix at other positions than the one being
+        // written (e.g. 'a = transpose(a)'): evaluated into a temporary first -
+        // element-wise reads of this matrix are evaluated in place
+        if (expr.aliases(*this)) {
+            Matrix<T> temporary{ getCols(), getRows(), m_stride == getCols() ? RowPadding::None : RowPadding::CacheLine };
+            temporary = expr;
+
+            if constexpr (std::is_same_v<TStorage, typename Matrix<T>::storage_type>) {
+                m_values = std::move(temporary.m_values);
+            }
+            else {
+                *this = temporary;
+            }
+            return *this;
+        }
+
+        if constexpr (Instrumented) {
+            const auto start{ std::chrono::steady_clock::now() };
+            assign(expr);
+            Instrumentation::instance().record(expr, getCols() * getRows(), sizeof(T), std::chrono::steady_clock::now() - start);
+        }
+        else {
+            assign(expr);
+        }
+        return *this;
+    }
+
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    void Matrix<T, TStorage>::assign(const TExpr& expr) {
+
+        if constexpr (Verbose) {
+            for (size_t y{}; y != getRows(); ++y) {
+                for (size_t x{}; x != getCols(); ++x) {
+                    T sum = expr(x, y);
+                    std::cout << "Matrix::    assigning expression result " << sum << std::endl;
+                    (*this)(x, y) = sum;
+                }
+            }
+        }
+        else {
+            if constexpr (ReleasableStorage<TStorage>) {
+                evaluateStreaming(expr);
+            }
+            else if (m_values.size() >= ParallelThreshold && WorkerPool::instance().concurrency() > 1) {
+                evaluateParallel(expr, 0, getRows());
+            }
+            else {
+                evaluate(expr, 0, getRows());
+            }
+        }
+    }
+
+    // evaluation of the rows [first, last) - linear, if all operands share the stride
+    // of this matrix: whole SIMD packets first, then the scalar tail
+    // (an expression of another element type is converted to 'T')
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    void Matrix<T, TStorage>::evaluate(const TExpr& expr, size_t first, size_t last) {
+
+        constexpr size_t Lanes{ Packet<T>::Lanes };
+
+        CacheScope::open(last * m_stride, getCols());
+
+        if constexpr (TExpr::IsLinear) {
+
+            const size_t stride{ expr.getStride() };
+
+            if (stride == 0 || stride == m_stride) {
+
+                const size_t begin{ first * m_stride };
+                const size_t end{ last * m_stride };
+
+                if (m_stride % Lanes == 0) {
+                    // each row starts on a packet boundary of the aligned storage: no tail
+                    for (size_t i{ begin }; i != end; i += Lanes) {
+                        evalAlignedAs<T>(expr, i).storeAligned(&m_values[i]);
+                    }
+                    return;
+                }
+
+                const size_t packetsEnd{ end - (end - begin) % Lanes };
+
+                size_t i{ begin };
+                for (; i != packetsEnd; i += Lanes) {
+                    evalAs<T>(expr, i).store(&m_values[i]);
+                }
+
+                for (; i != end; ++i) {
+                    m_values[i] = static_cast<T>(expr[i]);
+                }
+                return;
+            }
+        }
+
+        {
+            // views and operands with different strides: evaluation row by row
+            const size_t packetsEnd{ getCols() - getCols() % Lanes };
+
+            for (size_t y{ first }; y != last; ++y) {
+
+                T* row{ &m_values[y * m_stride] };
+
+                size_t x{};
+                for (; x != packetsEnd; x += Lanes) {
+                    evalAs<T>(expr, x, y).store(row + x);
+                }
+
+                for (; x != getCols(); ++x) {
+                    row[x] = static_cast<T>(expr(x, y));
+                }
+            }
+        }
+    }
+
+    // tiled evaluation of the rows [first, last): each tile consists of complete rows and fits into TileBytes
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    void Matrix<T, TStorage>::evaluateParallel(const TExpr& expr, size_t first, size_t last) {
+
+        const size_t tileRows{ rowsPerTile<T>(m_stride) };
+        const size_t tiles{ (last - first + tileRows - 1) / tileRows };
+
+        WorkerPool::instance().parallelFor(
+            tiles,
+            [&, this](size_t tile) {
+                const size_t begin{ first + tile * tileRows };
+                const size_t end{ std::min(begin + tileRows, last) };
+                evaluate(expr, begin, end);
+            }
+        );
+    }
+
+    // out-of-core evaluation: chunk after chunk of StreamingBytes, each one in parallel -
+    // afterwards the pages of the chunk are dropped from the target and from all
+    // (linear) operands, so the resident memory stays bounded
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    void Matrix<T, TStorage>::evaluateStreaming(const TExpr& expr) {
+
+        const size_t chunkRows{ std::max<size_t>(StreamingBytes / (m_stride * sizeof(T)), 1) };
+
+        for (size_t first{}; first < getRows(); first += chunkRows) {
+
+            const size_t last{ std::min(first + chunkRows, getRows()) };
+
+            if (WorkerPool::instance().concurrency() > 1) {
+                evaluateParallel(expr, first, last);
+            }
+            else {
+                evaluate(expr, first, last);
+            }
+
+            release(first, last);
+            if constexpr (ReleasableExpression<TExpr>) {
+                expr.release(first, last);
+            }
+        }
+    }
+
+    // ========================================================================
+
+    template <typename T>
+    Matrix<T> add3(const Matrix<T>& a, const Matrix<T>& b, const Matrix<T>& c)
+    {
+        Matrix<T> result{ a.getCols(), a.getRows() };
+        for (size_t y = 0; y != a.getRows(); ++y) {
+            for (size_t x = 0; x != a.getCols(); ++x) {
+                result(x, y) = a(x, y) + b(x, y) + c(x, y);
+            }
+        }
+        return result;
+    }
+
+    // add3 for any number of matrices: one loop, all operands written out
+    template <typename T, typename... TRest>
+    Matrix<T> addN(const Matrix<T>& first, const TRest&... rest)
+    {
+        Matrix<T> result{ first.getCols(), first.getRows() };
+        for (size_t y = 0; y != first.getRows(); ++y) {
+            for (size_t x = 0; x != first.getCols(); ++x) {
+                result(x, y) = (first(x, y) + ... + rest(x, y));
+            }
+        }
+        return result;
+    }
+
+    // ========================================================================
+
+    // any type which can be evaluated element-wise is a matrix expression
+    template <typename T>
+    concept MatrixExpression = requires (const T& expr, size_t x, size_t y) {
+        typename T::value_type;
+        expr(x, y);
+    };
+
+    // leaves owning their elements are referenced, all other (lightweight)
+    // nodes are stored by value - so no node refers to a destroyed temporary
+    template <typename T>
+    constexpr bool StoreByReference{ false };
+
+    template <typename T, typename TStorage>
+    constexpr bool StoreByReference<Matrix<T, TStorage>>{ true };
+
+    // sparse matrices are scattered, not evaluated element-wise: '+', '-' and
+    // scaling have overloads of their own (see SparseTerm and SparseSum)
+    template <typename T>
+    constexpr bool IsSparse{ false };
+
+    template <typename T>
+    concept DenseExpression = MatrixExpression<T> && !IsSparse<T>;
+
+    // ========================================================================
+    // dense vector: a Matrix of one row - expressions, reductions and the
+    // (parallel) linear evaluation apply unchanged, 'x + y' builds an expression
+
+    template <typename T = double>
+    class Vector : public Matrix<T>
+    {
+    public:
+        // c'tor(s)
+        explicit Vector(size_t size) : Matrix<T>{ size, 1 } {}
+
+        Vector(size_t size, T fill) : Matrix<T>{ size, 1 }
+        {
+            std::fill(this->data(), this->data() + size, fill);
+        }
+
+        Vector(std::initializer_list<T> values) : Matrix<T>{ values.size(), 1 }
+        {
+            std::copy(values.begin(), values.end(), this->data());
+        }
+
+        using Matrix<T>::operator=;
+
+        // getter
+        size_t size() const { return this->getCols(); }
+
+        const T& operator[](size_t i) const { return this->data()[i]; }
+        T& operator[](size_t i) { return this->data()[i]; }
+    };
+
+    template <typename T>
+    constexpr bool StoreByReference<Vector<T>>{ true };
+
+    template <typename T>
+    using ExprStorage = std::conditional_t<StoreByReference<T>, const T&, const T>;
+
+    // ========================================================================
+
+    // scalar leaf - the same value at every position
+    template <typename T = double>
+    class Scalar
+    {
+    private:
+        T m_value;
+
+    public:
+        using value_type = T;
+
+        static constexpr bool IsLinear{ true };
+
+        Scalar(T value) : m_value{ value } {}
+
+        void release(size_t, size_t) const {}
+
+        // a scalar adapts to the size and the stride of the other operands
+        size_t getCols() const { return 0; }
+        size_t getRows() const { return 0; }
+        size_t getStride() const { return 0; }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>&) const { return false; }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>&) const { return false; }
+
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; }
+
+        T operator() (size_t, size_t) const { return m_value; }
+        T operator[](size_t) const { return m_value; }
+        Packet<T> eval(size_t) const { return Packet<T>::broadcast(m_value); }
+        Packet<T> evalAligned(size_t) const { return Packet<T>::broadcast(m_value); }
+        Packet<T> eval(size_t, size_t) const { return Packet<T>::broadcast(m_value); }
+    };
+
+    template <typename TLHS, typename TRHS, typename TOp = Plus>
+    class MatrixExpr
+    {
+    private:
+        ExprStorage<TLHS> m_lhs;
+        ExprStorage<TRHS> m_rhs;
+
+    public:
+        using value_type = Promoted<typename TLHS::value_type, typename TRHS::value_type>;
+
+        static constexpr bool IsLinear{ TLHS::IsLinear && TRHS::IsLinear };
+
+        MatrixExpr(const TLHS& lhs, const TRHS& rhs) : m_rhs{ rhs }, m_lhs{ lhs } {}
+
+        size_t getCols() const { return std::max(m_lhs.getCols(), m_rhs.getCols()); }
+        size_t getRows() const { return std::max(m_lhs.getRows(), m_rhs.getRows()); }
+        size_t getStride() const { return commonStride(m_lhs.getStride(), m_rhs.getStride()); }
+
+        void release(size_t first, size_t last) const
+            requires ReleasableExpression<TLHS> && ReleasableExpression<TRHS>
+        {
+            m_lhs.release(first, last);
+            m_rhs.release(first, last);
+        }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_lhs.reads(matrix) || m_rhs.reads(matrix); }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_lhs.aliases(matrix) || m_rhs.aliases(matrix); }
+
+        void addCost(ExprCost& cost) const {
+            ++cost.m_nodes;
+            ++cost.m_flops;
+            m_lhs.addCost(cost);
+            m_rhs.addCost(cost);
+        }
+
+        value_type operator() (size_t x, size_t y) const {
+
+            if constexpr (Verbose) {
+                value_type l = m_lhs(x, y);
+                value_type r = m_rhs(x, y);
+                std::cout << "MatrixExpr:: evaluating " << l << TOp::Name << r << std::endl;
+                value_type tmp = TOp{}(l, r);
+                return tmp;
+            }
+            else {
+                return TOp{}(static_cast<value_type>(m_lhs(x, y)), static_cast<value_type>(m_rhs(x, y)));
+            }
+        }
+
+        value_type operator[](size_t i) const {
+            return TOp{}(static_cast<value_type>(m_lhs[i]), static_cast<value_type>(m_rhs[i]));
+        }
+
+        Packet<value_type> eval(size_t i) const {
+            return TOp{}(evalAs<value_type>(m_lhs, i), evalAs<value_type>(m_rhs, i));
+        }
+
+        Packet<value_type> evalAligned(size_t i) const {
+            return TOp{}(evalAlignedAs<value_type>(m_lhs, i), evalAlignedAs<value_type>(m_rhs, i));
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return TOp{}(evalAs<value_type>(m_lhs, x, y), evalAs<value_type>(m_rhs, x, y));
+        }
+    };
+
+    template <typename TExpr, typename TOp>
+    class MatrixUnaryExpr
+    {
+    private:
+        ExprStorage<TExpr> m_expr;
+
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ TExpr::IsLinear };
+
+        MatrixUnaryExpr(const TExpr& expr) : m_expr{ expr } {}
+
+        size_t getCols() const { return m_expr.getCols(); }
+        size_t getRows() const { return m_expr.getRows(); }
+        size_t getStride() const { return m_expr.getStride(); }
+
+        void release(size_t first, size_t last) const requires ReleasableExpression<TExpr> {
+            m_expr.release(first, last);
+        }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_expr.aliases(matrix); }
+
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; ++cost.m_flops; m_expr.addCost(cost); }
+
+        value_type operator() (size_t x, size_t y) const {
+
+            if constexpr (Verbose) {
+                value_type value{ m_expr(x, y) };
+                std::cout << "MatrixUnaryExpr:: evaluating " << TOp::Name << '(' << value << ')' << std::endl;
+                return TOp{}(value);
+            }
+            else {
+                return TOp{}(m_expr(x, y));
+            }
+        }
+
+        value_type operator[](size_t i) const {
+            return TOp{}(m_expr[i]);
+        }
+
+        Packet<value_type> eval(size_t i) const {
+            return TOp{}(m_expr.eval(i));
+        }
+
+        Packet<value_type> evalAligned(size_t i) const {
+            return TOp{}(m_expr.evalAligned(i));
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return TOp{}(m_expr.eval(x, y));
+        }
+    };
+
+    // ========================================================================
+    // masked selection: 'where(a > b, a - b, 0)' evaluates both alternatives and
+    // blends them lane by lane with the mask of the condition - no branches
+
+    // comparison node: as a value 1 or 0, as a condition its mask
+    template <typename TLHS, typename TRHS, typename TOp>
+    class MatrixCompareExpr
+    {
+    private:
+        ExprStorage<TLHS> m_lhs;
+        ExprStorage<TRHS> m_rhs;
+
+    public:
+        using value_type = Promoted<typename TLHS::value_type, typename TRHS::value_type>;
+
+        static constexpr bool IsLinear{ TLHS::IsLinear && TRHS::IsLinear };
+
+        MatrixCompareExpr(const TLHS& lhs, const TRHS& rhs) : m_lhs{ lhs }, m_rhs{ rhs } {}
+
+        size_t getCols() const { return std::max(m_lhs.getCols(), m_rhs.getCols()); }
+        size_t getRows() const { return std::max(m_lhs.getRows(), m_rhs.getRows()); }
+        size_t getStride() const { return commonStride(m_lhs.getStride(), m_rhs.getStride()); }
+
+        void release(size_t first, size_t last) const
+            requires ReleasableExpression<TLHS> && ReleasableExpression<TRHS>
+        {
+            m_lhs.release(first, last);
+            m_rhs.release(first, last);
+        }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_lhs.reads(matrix) || m_rhs.reads(matrix); }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_lhs.aliases(matrix) || m_rhs.aliases(matrix); }
+
+        void addCost(ExprCost& cost) const {
+            ++cost.m_nodes;
+            ++cost.m_flops;
+            m_lhs.addCost(cost);
+            m_rhs.addCost(cost);
+        }
+
+        value_type operator() (size_t x, size_t y) const {
+            return TOp{}(static_cast<value_type>(m_lhs(x, y)), static_cast<value_type>(m_rhs(x, y)));
+        }
+
+        value_type operator[](size_t i) const {
+            return TOp{}(static_cast<value_type>(m_lhs[i]), static_cast<value_type>(m_rhs[i]));
+        }
+
+        Packet<value_type> evalMask(size_t i) const {
+            return TOp{}(evalAs<value_type>(m_lhs, i), evalAs<value_type>(m_rhs, i));
+        }
+
+        Packet<value_type> evalMaskAligned(size_t i) const {
+            return TOp{}(evalAlignedAs<value_type>(m_lhs, i), evalAlignedAs<value_type>(m_rhs, i));
+        }
+
+        Packet<value_type> evalMask(size_t x, size_t y) const {
+            return TOp{}(evalAs<value_type>(m_lhs, x, y), evalAs<value_type>(m_rhs, x, y));
+        }
+
+        Packet<value_type> eval(size_t i) const { return toValue(evalMask(i)); }
+        Packet<value_type> evalAligned(size_t i) const { return toValue(evalMaskAligned(i)); }
+        Packet<value_type> eval(size_t x, size_t y) const { return toValue(evalMask(x, y)); }
+
+    private:
+        static Packet<value_type> toValue(Packet<value_type> mask) {
+            return select(mask, Packet<value_type>::broadcast(value_type{ 1 }), Packet<value_type>::broadcast(value_type{}));
+        }
+    };
+
+    template <typename T>
+    concept MaskExpression = requires (const T& expr, size_t i) {
+        expr.evalMask(i);
+    };
+
+    // mask of a condition in the lanes of 'T': a comparison of the same element type
+    // delivers it directly, any other expression is 'true' where it is nonzero
+    template <typename T, typename TCond>
+    Packet<T> maskAs(const TCond& cond, size_t i)
+    {
+        if constexpr (MaskExpression<TCond> && std::is_same_v<typename TCond::value_type, T>) {
+            return cond.evalMask(i);
+        }
+        else {
+            return cmpNotEqual(evalAs<T>(cond, i), Packet<T>::broadcast(T{}));
+        }
+    }
+
+    template <typename T, typename TCond>
+    Packet<T> maskAlignedAs(const TCond& cond, size_t i)
+    {
+        if constexpr (MaskExpression<TCond> && std::is_same_v<typename TCond::value_type, T>) {
+            return cond.evalMaskAligned(i);
+        }
+        else {
+            return cmpNotEqual(evalAlignedAs<T>(cond, i), Packet<T>::broadcast(T{}));
+        }
+    }
+
+    template <typename T, typename TCond>
+    Packet<T> maskAs(const TCond& cond, size_t x, size_t y)
+    {
+        if constexpr (MaskExpression<TCond> && std::is_same_v<typename TCond::value_type, T>) {
+            return cond.evalMask(x, y);
+        }
+        else {
+            return cmpNotEqual(evalAs<T>(cond, x, y), Packet<T>::broadcast(T{}));
+        }
+    }
+
+    // note: both alternatives are evaluated for every element, a division by zero
+    // in the discarded one yields 'inf' or 'nan' lanes, which are dropped unseen
+    template <typename TCond, typename TTrue, typename TFalse>
+    class MatrixSelectExpr
+    {
+    private:
+        ExprStorage<TCond> m_cond;
+        ExprStorage<TTrue> m_true;
+        ExprStorage<TFalse> m_false;
+
+    public:
+        using value_type = Promoted<typename TTrue::value_type, typename TFalse::value_type>;
+
+        static constexpr bool IsLinear{ TCond::IsLinear && TTrue::IsLinear && TFalse::IsLinear };
+
+        MatrixSelectExpr(const TCond& cond, const TTrue& onTrue, const TFalse& onFalse)
+            : m_cond{ cond }, m_true{ onTrue }, m_false{ onFalse } {}
+
+        size_t getCols() const { return std::max({ m_cond.getCols(), m_true.getCols(), m_false.getCols() }); }
+        size_t getRows() const { return std::max({ m_cond.getRows(), m_true.getRows(), m_false.getRows() }); }
+
+        size_t getStride() const {
+            return commonStride(commonStride(m_cond.getStride(), m_true.getStride()), m_false.getStride());
+        }
+
+        void release(size_t first, size_t last) const
+            requires ReleasableExpression<TCond> && ReleasableExpression<TTrue> && ReleasableExpression<TFalse>
+        {
+            m_cond.release(first, last);
+            m_true.release(first, last);
+            m_false.release(first, last);
+        }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const {
+            return m_cond.reads(matrix) || m_true.reads(matrix) || m_false.reads(matrix);
+        }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const {
+            return m_cond.aliases(matrix) || m_true.aliases(matrix) || m_false.aliases(matrix);
+        }
+
+        void addCost(ExprCost& cost) const {
+            ++cost.m_nodes;
+            ++cost.m_flops;
+            m_cond.addCost(cost);
+            m_true.addCost(cost);
+            m_false.addCost(cost);
+        }
+
+        // single elements: only the chosen alternative is evaluated
+        value_type operator() (size_t x, size_t y) const {
+            return m_cond(x, y) != typename TCond::value_type{}
+                ? static_cast<value_type>(m_true(x, y))
+                : static_cast<value_type>(m_false(x, y));
+        }
+
+        value_type operator[](size_t i) const {
+            return m_cond[i] != typename TCond::value_type{}
+                ? static_cast<value_type>(m_true[i])
+                : static_cast<value_type>(m_false[i]);
+        }
+
+        Packet<value_type> eval(size_t i) const {
+            return select(maskAs<value_type>(m_cond, i), evalAs<value_type>(m_true, i), evalAs<value_type>(m_false, i));
+        }
+
+        Packet<value_type> evalAligned(size_t i) const {
+            return select(maskAlignedAs<value_type>(m_cond, i), evalAlignedAs<value_type>(m_true, i), evalAlignedAs<value_type>(m_false, i));
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return select(maskAs<value_type>(m_cond, x, y), evalAs<value_type>(m_true, x, y), evalAs<value_type>(m_false, x, y));
+        }
+    };
+
+    // ========================================================================
+    // views: non-owning leaves presenting (a part of) another expression,
+    // nothing is copied - only the viewed elements are ever touched
+
+    template <typename TExpr>
+    class TransposeView
+    {
+    private:
+        ExprStorage<TExpr> m_expr;
+
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ false };
+
+        TransposeView(const TExpr& expr) : m_expr{ expr } {}
+
+        size_t getCols() const { return m_expr.getRows(); }
+        size_t getRows() const { return m_expr.getCols(); }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        // element (x, y) is read from (y, x)
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; m_expr.addCost(cost); }
+
+        value_type operator() (size_t x, size_t y) const {
+            return m_expr(y, x);
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return makePacket<value_type>([&](size_t k) { return m_expr(y, x + k); });
+        }
+    };
+
+    // rectangular block: 'cols' x 'rows' elements starting at (x, y)
+    template <typename TExpr>
+    class BlockView
+    {
+    private:
+        ExprStorage<TExpr> m_expr;
+        size_t m_x;
+        size_t m_y;
+        size_t m_cols;
+        size_t m_rows;
+
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ false };
+
+        BlockView(const TExpr& expr, size_t x, size_t y, size_t cols, size_t rows)
+            : m_expr{ expr }, m_x{ x }, m_y{ y }, m_cols{ cols }, m_rows{ rows }
+        {
+            if (x + cols > expr.getCols() || y + rows > expr.getRows()) {
+                throw std::out_of_range("BlockView exceeds the viewed expression");
+            }
+        }
+
+        size_t getCols() const { return m_cols; }
+        size_t getRows() const { return m_rows; }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        // a block at the origin reads each element from the same position
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const {
+            return (m_x == 0 && m_y == 0) ? m_expr.aliases(matrix) : m_expr.reads(matrix);
+        }
+
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; m_expr.addCost(cost); }
+
+        value_type operator() (size_t x, size_t y) const {
+            return m_expr(m_x + x, m_y + y);
+        }
+
+        // the lanes of a block row are contiguous in the viewed expression
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return m_expr.eval(m_x + x, m_y + y);
+        }
+    };
+
+    // every 'strideX'-th column of every 'strideY'-th row, starting at (x, y)
+    template <typename TExpr>
+    class StridedView
+    {
+    private:
+        ExprStorage<TExpr> m_expr;
+        size_t m_x;
+        size_t m_y;
+        size_t m_cols;
+        size_t m_rows;
+        size_t m_strideX;
+        size_t m_strideY;
+
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ false };
+
+        StridedView(const TExpr& expr, size_t x, size_t y, size_t cols, size_t rows, size_t strideX, size_t strideY)
+            : m_expr{ expr }, m_x{ x }, m_y{ y }, m_cols{ cols }, m_rows{ rows }, m_strideX{ strideX }, m_strideY{ strideY }
+        {
+            if (cols != 0 && rows != 0 &&
+                (x + (cols - 1) * strideX >= expr.getCols() || y + (rows - 1) * strideY >= expr.getRows())) {
+                throw std::out_of_range("StridedView exceeds the viewed expression");
+            }
+        }
+
+        size_t getCols() const { return m_cols; }
+        size_t getRows() const { return m_rows; }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; m_expr.addCost(cost); }
+
+        value_type operator() (size_t x, size_t y) const {
+            return m_expr(m_x + x * m_strideX, m_y + y * m_strideY);
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            return makePacket<value_type>([&](size_t k) { return (*this)(x + k, y); });
+        }
+    };
+
+    template <MatrixExpression TExpr>
+    TransposeView<TExpr> transpose(const TExpr& expr) {
+        return TransposeView<TExpr>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    BlockView<TExpr> block(const TExpr& expr, size_t x, size_t y, size_t cols, size_t rows) {
+        return BlockView<TExpr>(expr, x, y, cols, rows);
+    }
+
+    template <MatrixExpression TExpr>
+    BlockView<TExpr> row(const TExpr& expr, size_t y) {
+        return BlockView<TExpr>(expr, 0, y, expr.getCols(), 1);
+    }
+
+    template <MatrixExpression TExpr>
+    BlockView<TExpr> column(const TExpr& expr, size_t x) {
+        return BlockView<TExpr>(expr, x, 0, 1, expr.getRows());
+    }
+
+    template <MatrixExpression TExpr>
+    StridedView<TExpr> strided(const TExpr& expr, size_t x, size_t y, size_t cols, size_t rows, size_t strideX, size_t strideY) {
+        return StridedView<TExpr>(expr, x, y, cols, rows, strideX, strideY);
+    }
+
+    // ========================================================================
+    // common subexpressions: 'shared(a + b)' marks a subtree used several times in one
+    // assignment, e.g. 'hadamard(s, c) + hadamard(s, d)' with 's = shared(a + b)'.
+    // Its copies share one per-thread cache: the first consumer evaluates a block of
+    // SharedBlockBytes (within the current tile), all other consumers read it back.
+    // Packets are cached, single elements (tails, transposed or strided consumers) are not.
+    // The matrices of the subtree are referenced and must outlive 's'; a plain Matrix
+    // is a leaf already and cannot be shared
+
+    template <typename TExpr>
+    class SharedExpr
+    {
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ TExpr::IsLinear };
+
+    private:
+        static constexpr size_t Linear{ std::numeric_limits<size_t>::max() };
+        static constexpr size_t BlockSize{ SharedBlockBytes / sizeof(value_type) };
+        static constexpr size_t Slots{ 4 };
+
+        struct Cache
+        {
+            size_t m_owner;
+            size_t m_generation;
+            size_t m_used;        // last lookup, for the LRU replacement
+            size_t m_row;         // 'Linear': linear indices
+            size_t m_first;
+            size_t m_last;
+            std::vector<value_type, AlignedAllocator<value_type>> m_values;
+        };
+
+        ExprStorage<TExpr> m_expr;
+        size_t m_id;              // the same for all copies of this node
+
+    public:
+        SharedExpr(const TExpr& expr) : m_expr{ expr }, m_id{ nextId() } {}
+
+        size_t getCols() const { return m_expr.getCols(); }
+        size_t getRows() const { return m_expr.getRows(); }
+        size_t getStride() const { return m_expr.getStride(); }
+
+        void release(size_t first, size_t last) const requires ReleasableExpression<TExpr> {
+            m_expr.release(first, last);
+        }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_expr.aliases(matrix); }
+
+        // counted for each consumer - an upper bound, the cache evaluates it once
+        void addCost(ExprCost& cost) const { ++cost.m_nodes; m_expr.addCost(cost); }
+
+        value_type operator() (size_t x, size_t y) const {
+            return m_expr(x, y);
+        }
+
+        value_type operator[](size_t i) const {
+            return m_expr[i];
+        }
+
+        Packet<value_type> eval(size_t i) const {
+            const Cache* cache{ lookup(Linear, i, Packet<value_type>::Lanes) };
+            return cache ? Packet<value_type>::load(&cache->m_values[i - cache->m_first]) : m_expr.eval(i);
+        }
+
+        Packet<value_type> evalAligned(size_t i) const {
+            return eval(i);
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+            const Cache* cache{ lookup(y, x, Packet<value_type>::Lanes) };
+            return cache ? Packet<value_type>::load(&cache->m_values[x - cache->m_first]) : m_expr.eval(x, y);
+        }
+
+    private:
+        static size_t nextId()
+        {
+            static std::atomic<size_t> id{};
+            return ++id;
+        }
+
+        struct Caches
+        {
+            std::array<Cache, Slots> m_slots;
+            size_t m_clock;
+        };
+
+        static Caches& caches()
+        {
+            thread_local Caches caches{};
+            return caches;
+        }
+
+        // the slot owned by this node, else the least recently used one - unless that
+        // one is in use within the current scope, too: more shared nodes than slots
+        // are evaluated directly instead of evicting each other block by block
+        Cache* slot(const CacheScope& scope) const
+        {
+            Caches& all{ caches() };
+
+            Cache* cache{ &all.m_slots.front() };
+            for (Cache& candidate : all.m_slots) {
+                if (candidate.m_owner == m_id) {
+                    cache = &candidate;
+                    break;
+                }
+                if (candidate.m_used < cache->m_used) {
+                    cache = &candidate;
+                }
+            }
+
+            if (cache->m_owner != m_id) {
+                if (cache->m_owner != 0 && cache->m_generation == scope.m_generation) {
+                    return nullptr;
+                }
+                cache->m_owner = m_id;
+                cache->m_first = cache->m_last = 0;   // empty: filled on the first lookup
+            }
+
+            cache->m_used = ++all.m_clock;
+            return cache;
+        }
+
+        // cache holding the elements [index, index + count) of 'row' - filled on a miss,
+        // nullptr outside of a scope or without a free slot
+        const Cache* lookup(size_t row, size_t index, size_t count) const
+        {
+            const CacheScope& scope{ CacheScope::current() };
+            const size_t end{ (row == Linear) ? scope.m_end : std::min(scope.m_cols, m_expr.getCols()) };
+            if (index + count > end) {
+                return nullptr;
+            }
+
+            Cache* slotted{ slot(scope) };
+            if (slotted == nullptr) {
+                return nullptr;
+            }
+
+            Cache& cache{ *slotted };
+            const bool hit{
+                cache.m_generation == scope.m_generation && cache.m_row == row &&
+                cache.m_first <= index && index + count <= cache.m_last
+            };
+
+            if (!hit) {
+                cache.m_generation = scope.m_generation;
+                cache.m_row = row;
+                cache.m_first = index;
+                cache.m_last = std::min(index + BlockSize, end);
+                cache.m_values.resize(BlockSize);
+
+                if (row == Linear) {
+                    fillLinear(cache);
+                }
+                else {
+                    fillRow(cache);
+                }
+            }
+            return &cache;
+        }
+
+        void fillLinear(Cache& cache) const
+        {
+            if constexpr (IsLinear) {
+                constexpr size_t Lanes{ Packet<value_type>::Lanes };
+
+                size_t i{ cache.m_first };
+                for (; i + Lanes <= cache.m_last; i += Lanes) {
+                    m_expr.eval(i).store(&cache.m_values[i - cache.m_first]);
+                }
+                for (; i != cache.m_last; ++i) {
+                    cache.m_values[i - cache.m_first] = m_expr[i];
+                }
+            }
+        }
+
+        void fillRow(Cache& cache) const
+        {
+            constexpr size_t Lanes{ Packet<value_type>::Lanes };
+
+            size_t x{ cache.m_first };
+            for (; x + Lanes <= cache.m_last; x += Lanes) {
+                m_expr.eval(x, cache.m_row).store(&cache.m_values[x - cache.m_first]);
+            }
+            for (; x != cache.m_last; ++x) {
+                cache.m_values[x - cache.m_first] = m_expr(x, cache.m_row);
+            }
+        }
+    };
+
+    template <MatrixExpression TExpr>
+    SharedExpr<TExpr> shared(const TExpr& expr) {
+        return SharedExpr<TExpr>(expr);
+    }
+
+    // leaves (Matrix, Vector, SparseMatrix) are read directly, nothing to cache
+    template <MatrixExpression TExpr>
+        requires StoreByReference<TExpr>
+    void shared(const TExpr& expr) = delete;
+
+    // ========================================================================
+    // stencils: each element is a weighted sum of its neighbourhood in the source
+    // expression. Packets run along a row; the source is read band by band (about
+    // TileBytes of rows plus a halo of 'radiusY' rows above and below) into a
+    // per-thread buffer, extended by the boundary values - so every tap is one load
+
+    // values outside of the source: 'Zero', nearest edge element ('Clamp'),
+    // periodic ('Wrap') or reflected at the edge element ('Mirror')
+    enum class Boundary { Zero, Clamp, Wrap, Mirror };
+
+    // weights of a (2 * radiusX + 1) x (2 * radiusY + 1) neighbourhood, row after row
+    template <typename T = double>
+    class Stencil
+    {
+    private:
+        size_t m_radiusX;
+        size_t m_radiusY;
+        std::vector<T> m_weights;
+
+    public:
+        // c'tor(s)
+        Stencil(std::initializer_list<std::initializer_list<T>> rows)
+            : m_radiusX{ rows.size() == 0 ? 0 : rows.begin()->size() / 2 }, m_radiusY{ rows.size() / 2 }
+        {
+            for (const auto& row : rows) {
+                if (row.size() != 2 * m_radiusX + 1) {
+                    throw std::invalid_argument("Stencil: rows must have the same odd length");
+                }
+                m_weights.insert(std::end(m_weights), row);
+            }
+
+            if (rows.size() % 2 == 0) {
+                throw std::invalid_argument("Stencil: odd number of rows expected");
+            }
+        }
+
+        // getter
+        size_t radiusX() const { return m_radiusX; }
+        size_t radiusY() const { return m_radiusY; }
+        size_t width() const { return 2 * m_radiusX + 1; }
+        size_t height() const { return 2 * m_radiusY + 1; }
+
+        // weight of the neighbour (x - radiusX + dx, y - radiusY + dy)
+        T operator()(size_t dx, size_t dy) const { return m_weights[dy * width() + dx]; }
+
+        // rotated by 180 degrees: correlation with the flipped stencil is a convolution
+        Stencil flipped() const
+        {
+            Stencil result{ *this };
+            std::reverse(std::begin(result.m_weights), std::end(result.m_weights));
+            return result;
+        }
+
+        // mean of a (2 * radius + 1)^2 neighbourhood
+        static Stencil box(size_t radius)
+        {
+            const size_t count{ (2 * radius + 1) * (2 * radius + 1) };
+            return Stencil{ radius, radius, std::vector<T>(count, static_cast<T>(1.0 / static_cast<double>(count))) };
+        }
+
+        static Stencil laplacian()
+        {
+            return { { 0, 1, 0 }, { 1, -4, 1 }, { 0, 1, 0 } };
+        }
+
+    private:
+        Stencil(size_t radiusX, size_t radiusY, std::vector<T> weights)
+            : m_radiusX{ radiusX }, m_radiusY{ radiusY }, m_weights{ std::move(weights) } {}
+    };
+
+    // position of the source element representing 'index' (may lie outside [0, size)),
+    // 'std::nullopt' for zero boundaries
+    inline std::optional<size_t> boundaryIndex(std::ptrdiff_t index, size_t size, Boundary boundary)
+    {
+        const std::ptrdiff_t n{ static_cast<std::ptrdiff_t>(size) };
+        if (index >= 0 && index < n) {
+            return static_cast<size_t>(index);
+        }
+
+        switch (boundary) {
+        case Boundary::Clamp:
+            return static_cast<size_t>(std::clamp<std::ptrdiff_t>(index, 0, n - 1));
+        case Boundary::Wrap:
+            return static_cast<size_t>((index % n + n) % n);
+        case Boundary::Mirror:
+            // period 2n - 2: ... 2 1 [0 1 2 ... n-1] n-2 n-3 ...
+            if (n == 1) {
+                return 0;
+            }
+            else {
+                const std::ptrdiff_t period{ 2 * n - 2 };
+                const std::ptrdiff_t folded{ (index % period + period) % period };
+                return static_cast<size_t>(folded < n ? folded : period - folded);
+            }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    template <typename TExpr>
+    class StencilExpr
+    {
+    public:
+        using value_type = typename TExpr::value_type;
+
+        static constexpr bool IsLinear{ false };
+
+    private:
+        static constexpr size_t Slots{ 4 };
+
+        // rows [m_first - radiusY, m_last + radiusY) of the source,
+        // each one extended by radiusX boundary values on both sides
+        struct Band
+        {
+            size_t m_owner;
+            size_t m_generation;
+            size_t m_used;        // last lookup, for the LRU replacement
+            size_t m_first;
+            size_t m_last;
+            std::vector<value_type, AlignedAllocator<value_type>> m_values;
+        };
+
+        struct Bands
+        {
+            std::array<Band, Slots> m_slots;
+            size_t m_clock;
+        };
+
+        ExprStorage<TExpr> m_expr;
+        Stencil<value_type> m_stencil;
+        Boundary m_boundary;
+        size_t m_id;              // the same for all copies of this node
+
+    public:
+        StencilExpr(const TExpr& expr, const Stencil<value_type>& stencil, Boundary boundary)
+            : m_expr{ expr }, m_stencil{ stencil }, m_boundary{ boundary }, m_id{ nextId() } {}
+
+        size_t getCols() const { return m_expr.getCols(); }
+        size_t getRows() const { return m_expr.getRows(); }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        // the neighbours are read
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>& matrix) const { return m_expr.reads(matrix); }
+
+        // one multiply-add per tap, the source is evaluated once per element (into the band)
+        void addCost(ExprCost& cost) const {
+            ++cost.m_nodes;
+            cost.m_flops += 2.0 * static_cast<double>(m_stencil.width() * m_stencil.height());
+            m_expr.addCost(cost);
+        }
+
+        // single elements (tails, transposed consumers) are computed directly
+        value_type operator() (size_t x, size_t y) const {
+
+            value_type result{};
+            for (size_t dy{}; dy != m_stencil.height(); ++dy) {
+
+                const auto sy{ boundaryIndex(static_cast<std::ptrdiff_t>(y + dy) - static_cast<std::ptrdiff_t>(m_stencil.radiusY()), getRows(), m_boundary) };
+                if (!sy) {
+                    continue;
+                }
+
+                for (size_t dx{}; dx != m_stencil.width(); ++dx) {
+                    const auto sx{ boundaryIndex(static_cast<std::ptrdiff_t>(x + dx) - static_cast<std::ptrdiff_t>(m_stencil.radiusX()), getCols(), m_boundary) };
+                    if (sx) {
+                        result += m_stencil(dx, dy) * m_expr(*sx, *sy);
+                    }
+                }
+            }
+            return result;
+        }
+
+        Packet<value_type> eval(size_t x, size_t y) const {
+
+            const Band* found{ lookup(y) };
+            if (found == nullptr) {
+                alignas(Packet<value_type>) value_type lanes[Packet<value_type>::Lanes];
+                for (size_t lane{}; lane != Packet<value_type>::Lanes; ++lane) {
+                    lanes[lane] = (*this)(x + lane, y);
+                }
+                return Packet<value_type>::loadAligned(lanes);
+            }
+
+            const Band& band{ *found };
+            const size_t stride{ getCols() + 2 * m_stencil.radiusX() };
+            const value_type* origin{ &band.m_values[(y - band.m_first) * stride + x] };
+
+            Packet<value_type> result{ Packet<value_type>::broadcast(value_type{}) };
+            for (size_t dy{}; dy != m_stencil.height(); ++dy) {
+                for (size_t dx{}; dx != m_stencil.width(); ++dx) {
+                    result = fma(
+                        Packet<value_type>::broadcast(m_stencil(dx, dy)),
+                        Packet<value_type>::load(origin + dy * stride + dx),
+                        result
+                    );
+                }
+            }
+            return result;
+        }
+
+    private:
+        static size_t nextId()
+        {
+            static std::atomic<size_t> id{};
+            return ++id;
+        }
+
+        static Bands& bands()
+        {
+            thread_local Bands bands{};
+            return bands;
+        }
+
+        // the band owned by this node, else the least recently used one - nullptr
+        // if that one is in use within the current scope, too (see SharedExpr::slot)
+        Band* slot(const CacheScope& scope) const
+        {
+            Bands& all{ bands() };
+
+            Band* band{ &all.m_slots.front() };
+            for (Band& candidate : all.m_slots) {
+                if (candidate.m_owner == m_id) {
+                    band = &candidate;
+                    break;
+                }
+                if (candidate.m_used < band->m_used) {
+                    band = &candidate;
+                }
+            }
+
+            if (band->m_owner != m_id) {
+                if (band->m_owner != 0 && band->m_generation == scope.m_generation) {
+                    return nullptr;
+                }
+                band->m_owner = m_id;
+                band->m_first = band->m_last = 0;
+            }
+
+            band->m_used = ++all.m_clock;
+            return band;
+        }
+
+        // band holding row y - a new tile (CacheScope) starts a new band,
+        // nullptr without a free slot
+        const Band* lookup(size_t y) const
+        {
+            const CacheScope& scope{ CacheScope::current() };
+
+            Band* slotted{ slot(scope) };
+            if (slotted == nullptr) {
+                return nullptr;
+            }
+
+            Band& band{ *slotted };
+            const bool hit{
+                band.m_generation == scope.m_generation &&
+                band.m_first <= y && y < band.m_last
+            };
+
+            if (!hit) {
+                const size_t stride{ getCols() + 2 * m_stencil.radiusX() };
+                const size_t rows{ std::max<size_t>(TileBytes / (stride * sizeof(value_type)), 1) };
+
+                band.m_generation = scope.m_generation;
+                band.m_first = y;
+                band.m_last = std::min(y + rows, getRows());
+                band.m_values.resize((band.m_last - band.m_first + 2 * m_stencil.radiusY()) * stride);
+                fill(band);
+            }
+            return &band;
+        }
+
+        void fill(Band& band) const
+        {
+            constexpr size_t Lanes{ Packet<value_type>::Lanes };
+
+            const std::ptrdiff_t radiusX{ static_cast<std::ptrdiff_t>(m_stencil.radiusX()) };
+            const std::ptrdiff_t radiusY{ static_cast<std::ptrdiff_t>(m_stencil.radiusY()) };
+            const size_t cols{ getCols() };
+            const size_t stride{ cols + 2 * m_stencil.radiusX() };
+            const size_t packetsEnd{ cols - cols % Lanes };
+
+            value_type* row{ band.m_values.data() };
+
+            for (std::ptrdiff_t y{ static_cast<std::ptrdiff_t>(band.m_first) - radiusY };
+                 y != static_cast<std::ptrdiff_t>(band.m_last) + radiusY; ++y, row += stride) {
+
+                const auto sy{ boundaryIndex(y, getRows(), m_boundary) };
+                if (!sy) {
+                    std::fill(row, row + stride, value_type{});
+                    continue;
+                }
+
+                // interior, then the halo columns
+                value_type* interior{ row + radiusX };
+
+                size_t x{};
+                for (; x != packetsEnd; x += Lanes) {
+                    m_expr.eval(x, *sy).store(interior + x);
+                }
+                for (; x != cols; ++x) {
+                    interior[x] = m_expr(x, *sy);
+                }
+
+                for (std::ptrdiff_t k{ 1 }; k <= radiusX; ++k) {
+                    const auto left{ boundaryIndex(-k, cols, m_boundary) };
+                    const auto right{ boundaryIndex(static_cast<std::ptrdiff_t>(cols) - 1 + k, cols, m_boundary) };
+                    interior[-k] = left ? interior[*left] : value_type{};
+                    interior[cols - 1 + k] = right ? interior[*right] : value_type{};
+                }
+            }
+        }
+    };
+
+    // correlation: the stencil is laid onto the neighbourhood as it is
+    template <MatrixExpression TExpr>
+    StencilExpr<TExpr> stencil(const TExpr& expr, const Stencil<typename TExpr::value_type>& weights, Boundary boundary = Boundary::Clamp) {
+        return StencilExpr<TExpr>(expr, weights, boundary);
+    }
+
+    template <MatrixExpression TExpr>
+    StencilExpr<TExpr> convolve(const TExpr& expr, const Stencil<typename TExpr::value_type>& kernel, Boundary boundary = Boundary::Clamp) {
+        return StencilExpr<TExpr>(expr, kernel.flipped(), boundary);
+    }
+
+    // ========================================================================
+    // operators and functions building expression trees
+
+    template <DenseExpression TLHS, DenseExpression TRHS>
+    MatrixExpr<TLHS, TRHS> operator+(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixExpr<TLHS, TRHS>(lhs, rhs);
+    }
+
+    template <DenseExpression TLHS, DenseExpression TRHS>
+    MatrixExpr<TLHS, TRHS, Minus> operator-(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixExpr<TLHS, TRHS, Minus>(lhs, rhs);
+    }
+
+    // element-wise (Hadamard) product - 'operator*' is reserved for the matrix product
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixExpr<TLHS, TRHS, Multiplies> hadamard(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixExpr<TLHS, TRHS, Multiplies>(lhs, rhs);
+    }
+
+    // a scalar takes the element type of the expression: '0.5 * a' stays float for a float 'a'
+    template <MatrixExpression TExpr>
+    using ScalarOf = Scalar<typename TExpr::value_type>;
+
+    template <DenseExpression TExpr>
+    MatrixExpr<ScalarOf<TExpr>, TExpr, Multiplies> operator*(typename TExpr::value_type scalar, const TExpr& expr) {
+        return MatrixExpr<ScalarOf<TExpr>, TExpr, Multiplies>(ScalarOf<TExpr>{ scalar }, expr);
+    }
+
+    template <DenseExpression TExpr>
+    MatrixExpr<TExpr, ScalarOf<TExpr>, Multiplies> operator*(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixExpr<TExpr, ScalarOf<TExpr>, Multiplies>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <DenseExpression TExpr>
+    MatrixExpr<TExpr, ScalarOf<TExpr>, Divides> operator/(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixExpr<TExpr, ScalarOf<TExpr>, Divides>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <DenseExpression TExpr>
+    MatrixUnaryExpr<TExpr, Negate> operator-(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Negate>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixUnaryExpr<TExpr, Abs> abs(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Abs>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixUnaryExpr<TExpr, Sqrt> sqrt(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Sqrt>(expr);
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixUnaryExpr<TExpr, Exp> exp(const TExpr& expr) {
+        return MatrixUnaryExpr<TExpr, Exp>(expr);
+    }
+
+    // comparisons of two expressions or of an expression with a scalar (on the right)
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, Less> operator<(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, Less>(lhs, rhs);
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, LessEqual> operator<=(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, LessEqual>(lhs, rhs);
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, Greater> operator>(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, Greater>(lhs, rhs);
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, GreaterEqual> operator>=(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, GreaterEqual>(lhs, rhs);
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, Equal> operator==(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, Equal>(lhs, rhs);
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    MatrixCompareExpr<TLHS, TRHS, NotEqual> operator!=(const TLHS& lhs, const TRHS& rhs) {
+        return MatrixCompareExpr<TLHS, TRHS, NotEqual>(lhs, rhs);
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Less> operator<(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Less>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, LessEqual> operator<=(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, LessEqual>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Greater> operator>(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Greater>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, GreaterEqual> operator>=(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, GreaterEqual>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Equal> operator==(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, Equal>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixCompareExpr<TExpr, ScalarOf<TExpr>, NotEqual> operator!=(const TExpr& expr, typename TExpr::value_type scalar) {
+        return MatrixCompareExpr<TExpr, ScalarOf<TExpr>, NotEqual>(expr, ScalarOf<TExpr>{ scalar });
+    }
+
+    // 'cond ? onTrue : onFalse' per element - either alternative may be a scalar
+    template <MatrixExpression TCond, MatrixExpression TTrue, MatrixExpression TFalse>
+    MatrixSelectExpr<TCond, TTrue, TFalse> where(const TCond& cond, const TTrue& onTrue, const TFalse& onFalse) {
+        return MatrixSelectExpr<TCond, TTrue, TFalse>(cond, onTrue, onFalse);
+    }
+
+    template <MatrixExpression TCond, MatrixExpression TTrue>
+    MatrixSelectExpr<TCond, TTrue, ScalarOf<TTrue>> where(const TCond& cond, const TTrue& onTrue, typename TTrue::value_type onFalse) {
+        return MatrixSelectExpr<TCond, TTrue, ScalarOf<TTrue>>(cond, onTrue, ScalarOf<TTrue>{ onFalse });
+    }
+
+    template <MatrixExpression TCond, MatrixExpression TFalse>
+    MatrixSelectExpr<TCond, ScalarOf<TFalse>, TFalse> where(const TCond& cond, typename TFalse::value_type onTrue, const TFalse& onFalse) {
+        return MatrixSelectExpr<TCond, ScalarOf<TFalse>, TFalse>(cond, ScalarOf<TFalse>{ onTrue }, onFalse);
+    }
+
+    // ========================================================================
+    // deferred evaluation: assignments are recorded (the expression nodes are
+    // copied, matrices are referenced) and executed together - tile by tile,
+    // each tile runs through all statements while it is cache-resident
+
+    class DeferredEvaluation
+    {
+    private:
+        struct Statement
+        {
+            Matrix<>* m_target;
+            std::function<void(size_t, size_t)> m_evaluate;
+            std::function<bool(const Matrix<>&)> m_aliases;
+        };
+
+        std::vector<Statement> m_statements;
+        size_t m_passes;
+
+    public:
+        // c'tor(s) / d'tor
+        DeferredEvaluation() : m_passes{} {}
+
+        ~DeferredEvaluation()
+        {
+            execute();
+        }
+
+        DeferredEvaluation(const DeferredEvaluation&) = delete;
+        DeferredEvaluation& operator=(const DeferredEvaluation&) = delete;
+
+        // getter
+        size_t getPasses() const { return m_passes; }
+
+        // records 'target = expr' - all matrices of the expression must outlive
+        // the execution; targets are Matrix<> (double, default storage) only,
+        // expressions without a size (e.g. Scalar) fit any target
+        template <MatrixExpression TExpr>
+        void assign(Matrix<>& target, const TExpr& expr)
+        {
+            if (expr.getCols() != 0 && (expr.getCols() != target.getCols() || expr.getRows() != target.getRows())) {
+                throw std::invalid_argument("DeferredEvaluation: target and expression differ in size");
+            }
+
+            // reading the own target at other positions needs a temporary:
+            // executed right away, after the pending statements
+            if (expr.aliases(target)) {
+                execute();
+                target = expr;
+                return;
+            }
+
+            Statement statement{
+                &target,
+                [&target, expr](size_t first, size_t last) { target.evaluate(expr, first, last); },
+                [expr](const Matrix<>& matrix) { return expr.aliases(matrix); }
+            };
+
+            if (!m_statements.empty() && !canJoin(statement)) {
+                execute();
+            }
+
+            m_statements.push_back(std::move(statement));
+        }
+
+        // executes all pending statements in one fused traversal
+        void execute()
+        {
+            if (m_statements.empty()) {
+                return;
+            }
+
+            const Matrix<>& first{ *m_statements.front().m_target };
+            const size_t cols{ first.getCols() };
+            const size_t rows{ first.getRows() };
+            const size_t tileRows{ rowsPerTile<double>(first.getStride()) };
+            const size_t tiles{ (rows + tileRows - 1) / tileRows };
+
+            auto evaluateTile = [&](size_t tile) {
+                const size_t firstRow{ tile * tileRows };
+                const size_t lastRow{ std::min(firstRow + tileRows, rows) };
+                for (const auto& statement : m_statements) {
+                    statement.m_evaluate(firstRow, lastRow);
+                }
+            };
+
+            if (cols * rows >= ParallelThreshold && WorkerPool::instance().concurrency() > 1) {
+                WorkerPool::instance().parallelFor(tiles, evaluateTile);
+            }
+            else {
+                for (size_t tile{}; tile != tiles; ++tile) {
+                    evaluateTile(tile);
+                }
+            }
+
+            m_statements.clear();
+            ++m_passes;
+        }
+
+    private:
+        // a statement may join the pending ones, if tile-wise execution keeps the
+        // statement order for each element: all targets have the same size and a
+        // matrix written by one statement is read by another one element-wise only
+        bool canJoin(const Statement& statement) const
+        {
+            const Matrix<>& first{ *m_statements.front().m_target };
+            if (statement.m_target->getCols() != first.getCols() ||
+                statement.m_target->getRows() != first.getRows()) {
+                return false;
+            }
+
+            for (const auto& pending : m_statements) {
+
+                // read after write
+                if (statement.m_aliases(*pending.m_target)) {
+                    return false;
+                }
+
+                // write after read
+                if (pending.m_aliases(*statement.m_target)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // ========================================================================
+    // reductions: each one consumes an expression in one streaming pass,
+    // no Matrix object is materialized
+
+    // several independent accumulators break the dependency chain
+    // between consecutive iterations, so the loop keeps the SIMD units busy
+    constexpr size_t ReductionAccumulators{ 4 };
+
+    template <typename TExpr, typename TOp, typename T = typename TExpr::value_type>
+    T reduce(const TExpr& expr, T init, TOp op)
+    {
+        constexpr size_t Lanes{ Packet<T>::Lanes };
+        constexpr size_t Step{ ReductionAccumulators * Lanes };
+
+        if constexpr (TExpr::IsLinear) {
+            CacheScope::open(expr.getRows() * expr.getStride(), expr.getCols());
+        }
+        else {
+            CacheScope::open(0, expr.getCols());
+        }
+
+        Packet<T> acc[ReductionAccumulators];
+        for (auto& packet : acc) {
+            packet = Packet<T>::broadcast(init);
+        }
+
+        T result{ init };
+
+        // consumes 'count' elements, 'packetAt' and 'elementAt' address them by 0, 1, ...
+        auto accumulate = [&](size_t count, auto packetAt, auto elementAt) {
+
+            size_t i{};
+            for (; i + Step <= count; i += Step) {
+                for (size_t k{}; k != ReductionAccumulators; ++k) {
+                    acc[k] = op(acc[k], packetAt(i + k * Lanes));
+                }
+            }
+            for (; i + Lanes <= count; i += Lanes) {
+                acc[0] = op(acc[0], packetAt(i));
+            }
+            for (; i != count; ++i) {
+                result = op(result, elementAt(i));
+            }
+        };
+
+        auto accumulateRows = [&]() {
+            for (size_t y{}; y != expr.getRows(); ++y) {
+                accumulate(
+                    expr.getCols(),
+                    [&](size_t x) { return expr.eval(x, y); },
+                    [&](size_t x) { return expr(x, y); }
+                );
+            }
+        };
+
+        if constexpr (TExpr::IsLinear) {
+            if (expr.getStride() == expr.getCols()) {
+                // no padding between the rows
+                accumulate(
+                    expr.getCols() * expr.getRows(),
+                    [&](size_t i) { return expr.eval(i); },
+                    [&](size_t i) { return expr[i]; }
+                );
+            }
+            else {
+                accumulateRows();
+            }
+        }
+        else {
+            accumulateRows();
+        }
+
+        // combine accumulators pairwise, then the lanes of the last one
+        for (size_t width{ ReductionAccumulators / 2 }; width != 0; width /= 2) {
+            for (size_t k{}; k != width; ++k) {
+                acc[k] = op(acc[k], acc[k + width]);
+            }
+        }
+
+        T lanes[Lanes];
+        acc[0].store(lanes);
+
+        for (T lane : lanes) {
+            result = op(result, lane);
+        }
+        return result;
+    }
+
+    // note: the result has the element type of the expression (integral sums may overflow)
+    template <MatrixExpression TExpr>
+    typename TExpr::value_type sum(const TExpr& expr) {
+        return reduce(expr, typename TExpr::value_type{}, Plus{});
+    }
+
+    template <MatrixExpression TLHS, MatrixExpression TRHS>
+    auto dot(const TLHS& lhs, const TRHS& rhs) {
+        return sum(hadamard(lhs, rhs));
+    }
+
+    // Frobenius norm
+    template <MatrixExpression TExpr>
+    auto norm2(const TExpr& expr) {
+        return std::sqrt(dot(expr, expr));
+    }
+
+    // ========================================================================
+    // BLAS level 1: each one is a single fused pass, no temporary
+    // (the operand 'x' may be any expression of matching size)
+
+    // y = alpha * x + y
+    template <typename T, MatrixExpression TExpr>
+    void axpy(T alpha, const TExpr& x, Vector<T>& y) {
+        y = alpha * x + y;
+    }
+
+    // x = alpha * x
+    template <typename T>
+    void scal(T alpha, Vector<T>& x) {
+        x = alpha * x;
+    }
+
+    // w = alpha * x + beta * y
+    template <typename T, MatrixExpression TLHS, MatrixExpression TRHS>
+    void waxpby(T alpha, const TLHS& x, T beta, const TRHS& y, Vector<T>& w) {
+        w = alpha * x + beta * y;
+    }
+
+    // Euclidean norm (BLAS name)
+    template <MatrixExpression TExpr>
+    auto nrm2(const TExpr& x) {
+        return norm2(x);
+    }
+
+    // integral types have no infinity, their extreme values are used instead
+    template <typename T>
+    constexpr T Largest{ std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max() };
+
+    template <typename T>
+    constexpr T Smallest{ std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest() };
+
+    template <MatrixExpression TExpr>
+    typename TExpr::value_type min(const TExpr& expr) {
+        return reduce(expr, Largest<typename TExpr::value_type>, Min{});
+    }
+
+    template <MatrixExpression TExpr>
+    typename TExpr::value_type max(const TExpr& expr) {
+        return reduce(expr, Smallest<typename TExpr::value_type>, Max{});
+    }
+
+    // ========================================================================
+    // matrix product: 'a * b' only builds a node, the product is computed
+    // when the node is assigned - by a cache-blocked, register-tiled kernel
+
+    // register tile (MR x NR) and cache blocks: MC x NC elements of the result,
+    // KC is the depth of the packed blocks of both operands
+    constexpr size_t GemmMR{ 4 };
+    constexpr size_t GemmNR{ 2 * Packet<double>::Lanes };
+    constexpr size_t GemmMC{ 64 };
+    constexpr size_t GemmNC{ 128 };
+    constexpr size_t GemmKC{ 256 };
+
+    // lazy product 'scale * lhs * rhs + addend' - the addend (a Scalar zero for a
+    // plain product) is fused into the write-back of the GEMM kernel; element-wise
+    // terms added, subtracted or scaled around the product fold into the addend
+    // (note: the product is available for Matrix<double> only)
+    template <typename TAddend>
+    class MatrixProduct
+    {
+    private:
+        const Matrix<>& m_lhs;
+        const Matrix<>& m_rhs;
+        ExprStorage<TAddend> m_addend;
+        double m_scale;
+
+    public:
+        using value_type = double;
+
+        MatrixProduct(const Matrix<>& lhs, const Matrix<>& rhs, const TAddend& addend, double scale = 1.0)
+            : m_lhs{ lhs }, m_rhs{ rhs }, m_addend{ addend }, m_scale{ scale }
+        {
+            if (lhs.getCols() != rhs.getRows()) {
+                throw std::invalid_argument("Matrix product: lhs columns and rhs rows differ");
+            }
+
+            if (addend.getCols() != 0 && (addend.getCols() != rhs.getCols() || addend.getRows() != lhs.getRows())) {
+                throw std::invalid_argument("Matrix product: addend has wrong dimensions");
+            }
+        }
+
+        // getter
+        const Matrix<>& lhs() const { return m_lhs; }
+        const Matrix<>& rhs() const { return m_rhs; }
+        const TAddend& addend() const { return m_addend; }
+        double scale() const { return m_scale; }
+
+        size_t getCols() const { return m_rhs.getCols(); }
+        size_t getRows() const { return m_lhs.getRows(); }
+    };
+
+    inline MatrixProduct<Scalar<>> operator*(const Matrix<>& lhs, const Matrix<>& rhs) {
+        return MatrixProduct<Scalar<>>(lhs, rhs, Scalar{ 0.0 });
+    }
+
+    // 'a * b + d': the zero addend is replaced
+    template <MatrixExpression TExpr>
+    MatrixProduct<TExpr> operator+(const MatrixProduct<Scalar<>>& product, const TExpr& addend) {
+        return MatrixProduct<TExpr>(product.lhs(), product.rhs(), addend, product.scale());
+    }
+
+    template <MatrixExpression TExpr>
+    MatrixProduct<TExpr> operator+(const TExpr& addend, const MatrixProduct<Scalar<>>& product) {
+        return MatrixProduct<TExpr>(product.lhs(), product.rhs(), addend, product.scale());
+    }
+
+    // 'a * b + d + e', 'a * b - d', 'd - a * b': the term is folded into the addend
+    template <typename TAddend, MatrixExpression TExpr>
+    MatrixProduct<MatrixExpr<TAddend, TExpr>> operator+(const MatrixProduct<TAddend>& product, const TExpr& expr) {
+        return { product.lhs(), product.rhs(), MatrixExpr<TAddend, TExpr>(product.addend(), expr), product.scale() };
+    }
+
+    template <typename TAddend, MatrixExpression TExpr>
+    MatrixProduct<MatrixExpr<TExpr, TAddend>> operator+(const TExpr& expr, const MatrixProduct<TAddend>& product) {
+        return { product.lhs(), product.rhs(), MatrixExpr<TExpr, TAddend>(expr, product.addend()), product.scale() };
+    }
+
+    template <typename TAddend, MatrixExpression TExpr>
+    MatrixProduct<MatrixExpr<TAddend, TExpr, Minus>> operator-(const MatrixProduct<TAddend>& product, const TExpr& expr) {
+        return { product.lhs(), product.rhs(), MatrixExpr<TAddend, TExpr, Minus>(product.addend(), expr), product.scale() };
+    }
+
+    template <typename TAddend, MatrixExpression TExpr>
+    MatrixProduct<MatrixExpr<TExpr, TAddend, Minus>> operator-(const TExpr& expr, const MatrixProduct<TAddend>& product) {
+        return { product.lhs(), product.rhs(), MatrixExpr<TExpr, TAddend, Minus>(expr, product.addend()), -product.scale() };
+    }
+
+    // 's * (a * b + d)': scales the product and the addend
+    template <typename TAddend>
+    MatrixProduct<MatrixExpr<Scalar<>, TAddend, Multiplies>> operator*(double scale, const MatrixProduct<TAddend>& product) {
+        return { product.lhs(), product.rhs(), MatrixExpr<Scalar<>, TAddend, Multiplies>(Scalar{ scale }, product.addend()), scale * product.scale() };
+    }
+
+    template <typename TAddend>
+    MatrixProduct<MatrixExpr<Scalar<>, TAddend, Multiplies>> operator*(const MatrixProduct<TAddend>& product, double scale) {
+        return scale * product;
+    }
+
+    template <typename TAddend>
+    MatrixProduct<MatrixExpr<Scalar<>, TAddend, Multiplies>> operator-(const MatrixProduct<TAddend>& product) {
+        return -1.0 * product;
+    }
+
+    namespace GemmKernel {
+
+        // copies rows [row, row + mc) and depth [k, k + kc) of 'a' into slivers
+        // of GemmMR rows, each one stored depth after depth (zero padded)
+        static void packLhs(const Matrix<>& a, size_t row, size_t mc, size_t k, size_t kc, double* packed)
+        {
+            for (size_t sliver{}; sliver < mc; sliver += GemmMR) {
+                for (size_t p{}; p != kc; ++p) {
+                    for (size_t r{}; r != GemmMR; ++r) {
+                        *packed++ = (sliver + r < mc) ? a(k + p, row + sliver + r) : 0.0;
+                    }
+                }
+            }
+        }
+
+        // copies depth [k, k + kc) and columns [col, col + nc) of 'b' into slivers
+        // of GemmNR columns, each one stored depth after depth (zero padded)
+        static void packRhs(const Matrix<>& b, size_t k, size_t kc, size_t col, size_t nc, double* packed)
+        {
+            for (size_t sliver{}; sliver < nc; sliver += GemmNR) {
+                for (size_t p{}; p != kc; ++p) {
+                    const double* src{ &b(col + sliver, k + p) };
+                    for (size_t c{}; c != GemmNR; ++c) {
+                        *packed++ = (sliver + c < nc) ? src[c] : 0.0;
+                    }
+                }
+            }
+        }
+
+        // GemmMR x GemmNR register tile: tile += packedLhs * packedRhs
+        static void microKernel(size_t kc, const double* packedLhs, const double* packedRhs, double* tile, size_t stride)
+        {
+            constexpr size_t Lanes{ Packet<double>::Lanes };
+            constexpr size_t Columns{ GemmNR / Lanes };
+
+            Packet<double> acc[GemmMR][Columns];
+            for (auto& row : acc) {
+                for (auto& packet : row) {
+                    packet = Packet<double>::broadcast(0.0);
+                }
+            }
+
+            for (size_t p{}; p != kc; ++p) {
+                Packet<double> b[Columns];
+                for (size_t c{}; c != Columns; ++c) {
+                    b[c] = Packet<double>::load(packedRhs + c * Lanes);
+                }
+                for (size_t r{}; r != GemmMR; ++r) {
+                    Packet<double> a{ Packet<double>::broadcast(packedLhs[r]) };
+                    for (size_t c{}; c != Columns; ++c) {
+                        acc[r][c] = fma(a, b[c], acc[r][c]);
+                    }
+                }
+                packedLhs += GemmMR;
+                packedRhs += GemmNR;
+            }
+
+            for (size_t r{}; r != GemmMR; ++r) {
+                for (size_t c{}; c != Columns; ++c) {
+                    double* dst{ tile + r * stride + c * Lanes };
+                    (acc[r][c] + Packet<double>::load(dst)).store(dst);
+                }
+            }
+        }
+
+        // computes the result block [row, row + mc) x [col, col + nc) over the whole
+        // depth and writes each element exactly once: c = scale * a * b + addend
+        template <typename TAddend>
+        void computeBlock(const Matrix<>& a, const Matrix<>& b, double scale, const TAddend& addend, Matrix<>& c,
+            size_t row, size_t mc, size_t col, size_t nc)
+        {
+            constexpr size_t Lanes{ Packet<double>::Lanes };
+
+            thread_local std::vector<double> packedLhs(GemmMC * GemmKC);
+            thread_local std::vector<double> packedRhs(GemmKC * GemmNC);
+            thread_local std::vector<double> tile(GemmMC * GemmNC);
+
+            std::fill(std::begin(tile), std::end(tile), 0.0);
+
+            CacheScope::open(0, col + nc);
+
+            const size_t depth{ a.getCols() };
+            for (size_t k{}; k < depth; k += GemmKC) {
+
+                const size_t kc{ std::min(GemmKC, depth - k) };
+                packLhs(a, row, mc, k, kc, packedLhs.data());
+                packRhs(b, k, kc, col, nc, packedRhs.data());
+
+                for (size_t j{}; j < nc; j += GemmNR) {
+                    for (size_t i{}; i < mc; i += GemmMR) {
+                        microKernel(kc, &packedLhs[i * kc], &packedRhs[j * kc], &tile[i * GemmNC + j], GemmNC);
+                    }
+                }
+            }
+
+            // write-back, fused with the scaling and the element-wise addend
+            const Packet<double> factor{ Packet<double>::broadcast(scale) };
+
+            for (size_t i{}; i != mc; ++i) {
+
+                const double* src{ &tile[i * GemmNC] };
+                double* dst{ &c(col, row + i) };
+
+                size_t j{};
+                for (; j + Lanes <= nc; j += Lanes) {
+                    fma(factor, Packet<double>::load(src + j), evalAs<double>(addend, col + j, row + i)).store(dst + j);
+                }
+                for (; j != nc; ++j) {
+                    dst[j] = scale * src[j] + addend(col + j, row + i);
+                }
+            }
+        }
+    }
+
+    // blocked product c = scale * a * b + addend, result blocks are distributed over the worker pool
+    template <typename TAddend>
+    void gemm(const Matrix<>& a, const Matrix<>& b, double scale, const TAddend& addend, Matrix<>& c)
+    {
+        const size_t rowBlocks{ (c.getRows() + GemmMC - 1) / GemmMC };
+        const size_t colBlocks{ (c.getCols() + GemmNC - 1) / GemmNC };
+
+        auto computeBlock = [&](size_t block) {
+            const size_t row{ (block / colBlocks) * GemmMC };
+            const size_t col{ (block % colBlocks) * GemmNC };
+            GemmKernel::computeBlock(a, b, scale, addend, c,
+                row, std::min(GemmMC, c.getRows() - row),
+                col, std::min(GemmNC, c.getCols() - col));
+        };
+
+        const size_t blocks{ rowBlocks * colBlocks };
+        if (blocks > 1 && WorkerPool::instance().concurrency() > 1) {
+            WorkerPool::instance().parallelFor(blocks, computeBlock);
+        }
+        else {
+            for (size_t block{}; block != blocks; ++block) {
+                computeBlock(block);
+            }
+        }
+    }
+
+    template <typename T, typename TStorage>
+    template <typename TAddend>
+    Matrix<T, TStorage>& Matrix<T, TStorage>::operator=(const MatrixProduct<TAddend>& product) {
+
+        static_assert(std::is_same_v<T, double>, "Matrix product: available for Matrix<double> only");
+
+        if (getCols() != product.getCols() || getRows() != product.getRows()) {
+            throw std::invalid_argument("Matrix product: result has wrong dimensions");
+        }
+
+        // the kernel reads operands block-wise - they must not be overwritten
+        // (the addend is read right before each write and may alias element-wise);
+        // the kernel writes into Matrix<> only - other storages get a temporary, too
+        constexpr bool DefaultStorage{ std::is_same_v<TStorage, typename Matrix<T>::storage_type> };
+
+        const bool aliased{
+            static_cast<const void*>(this) == static_cast<const void*>(&product.lhs()) ||
+            static_cast<const void*>(this) == static_cast<const void*>(&product.rhs()) ||
+            product.addend().aliases(*this)
+        };
+
+        if constexpr (DefaultStorage) {
+            if (!aliased) {
+                gemm(product.lhs(), product.rhs(), product.scale(), product.addend(), *this);
+                return *this;
+            }
+        }
+
+        Matrix<T> temporary{ getCols(), getRows(), m_stride == getCols() ? RowPadding::None : RowPadding::CacheLine };
+        gemm(product.lhs(), product.rhs(), product.scale(), product.addend(), temporary);
+
+        if constexpr (DefaultStorage) {
+            m_values = std::move(temporary.m_values);
+        }
+        else {
+            *this = temporary;
+        }
+        return *this;
+    }
+
+    // textbook triple loop, for comparison only
+    Matrix<> multiplyNaive(const Matrix<>& a, const Matrix<>& b)
+    {
+        Matrix<> result{ b.getCols(), a.getRows() };
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != b.getCols(); ++x) {
+                double sum{};
+                for (size_t k{}; k != a.getCols(); ++k) {
+                    sum += a(k, y) * b(x, k);
+                }
+                result(x, y) = sum;
+            }
+        }
+        return result;
+    }
+
+    // ========================================================================
+    // LU factorization with partial pivoting, PA = LU - blocked (right-looking):
+    // a panel of LuBlock columns is factorized, the rows of U right of it are
+    // solved for, then the trailing matrix is updated by a product of the
+    // panel and those rows, computed by the packed GEMM micro kernel in
+    // parallel blocks. Almost all of the work goes into this last step.
+
+    constexpr size_t LuBlock{ 64 };
+
+    static_assert(LuBlock <= GemmKC, "LU: a panel must fit into one packed block of the GEMM kernel");
+
+    namespace LuKernel {
+
+        // y[0, count) += alpha * x[0, count) - one row segment
+        static void axpyRow(double alpha, const double* x, double* y, size_t count)
+        {
+            constexpr size_t Lanes{ Packet<double>::Lanes };
+
+            const Packet<double> factor{ Packet<double>::broadcast(alpha) };
+
+            size_t i{};
+            for (; i + Lanes <= count; i += Lanes) {
+                fma(factor, Packet<double>::load(x + i), Packet<double>::load(y + i)).store(y + i);
+            }
+            for (; i != count; ++i) {
+                y[i] += alpha * x[i];
+            }
+        }
+
+        // unblocked factorization of the columns [col, col + width), rows [col, n),
+        // the row swaps are applied to the whole rows
+        static void factorizePanel(Matrix<>& a, size_t col, size_t width, std::vector<size_t>& pivots)
+        {
+            const size_t n{ a.getRows() };
+
+            for (size_t j{ col }; j != col + width; ++j) {
+
+                size_t pivot{ j };
+                for (size_t i{ j + 1 }; i != n; ++i) {
+                    if (std::abs(a(j, i)) > std::abs(a(j, pivot))) {
+                        pivot = i;
+                    }
+                }
+
+                if (a(j, pivot) == 0.0) {
+                    throw std::runtime_error("LU: matrix is singular");
+                }
+
+                pivots[j] = pivot;
+                if (pivot != j) {
+                    std::swap_ranges(&a(0, j), &a(0, j) + n, &a(0, pivot));
+                }
+
+                // column j of L, then the rank-1 update of the rest of the panel
+                const double inverse{ 1.0 / a(j, j) };
+                for (size_t i{ j + 1 }; i != n; ++i) {
+                    a(j, i) *= inverse;
+                    axpyRow(-a(j, i), &a(j + 1, j), &a(j + 1, i), col + width - j - 1);
+                }
+            }
+        }
+
+        // rows [col, col + width) of U right of the panel: L11^-1 * A12, restricted to
+        // the columns [first, last) - the column ranges are independent of each other
+        static void solveRows(Matrix<>& a, size_t col, size_t width, size_t first, size_t last)
+        {
+            for (size_t r{ col + 1 }; r != col + width; ++r) {
+                for (size_t j{ col }; j != r; ++j) {
+                    axpyRow(-a(j, r), &a(first, j), &a(first, r), last - first);
+                }
+            }
+        }
+
+        // block [row, row + mc) x [colBegin, colBegin + nc) of the trailing matrix:
+        // A22 -= L21 * U12, the panel being the columns / rows [col, col + width)
+        static void updateBlock(Matrix<>& a, size_t col, size_t width,
+            size_t row, size_t mc, size_t colBegin, size_t nc)
+        {
+            constexpr size_t Lanes{ Packet<double>::Lanes };
+
+            thread_local std::vector<double> packedLhs(GemmMC * GemmKC);
+            thread_local std::vector<double> packedRhs(GemmKC * GemmNC);
+            thread_local std::vector<double> tile(GemmMC * GemmNC);
+
+            std::fill(std::begin(tile), std::end(tile), 0.0);
+
+            GemmKernel::packLhs(a, row, mc, col, width, packedLhs.data());
+            GemmKernel::packRhs(a, col, width, colBegin, nc, packedRhs.data());
+
+            for (size_t j{}; j < nc; j += GemmNR) {
+                for (size_t i{}; i < mc; i += GemmMR) {
+                    GemmKernel::microKernel(width, &packedLhs[i * width], &packedRhs[j * width], &tile[i * GemmNC + j], GemmNC);
+                }
+            }
+
+            for (size_t i{}; i != mc; ++i) {
+
+                const double* src{ &tile[i * GemmNC] };
+                double* dst{ &a(colBegin, row + i) };
+
+                size_t j{};
+                for (; j + Lanes <= nc; j += Lanes) {
+                    (Packet<double>::load(dst + j) - Packet<double>::load(src + j)).store(dst + j);
+                }
+                for (; j != nc; ++j) {
+                    dst[j] -= src[j];
+                }
+            }
+        }
+
+        // runs task(0), ..., task(count - 1) on the worker pool, if there is more than one
+        static void forEach(size_t count, const std::function<void(size_t)>& task)
+        {
+            if (count > 1 && WorkerPool::instance().concurrency() > 1) {
+                WorkerPool::instance().parallelFor(count, task);
+            }
+            else {
+                for (size_t index{}; index != count; ++index) {
+                    task(index);
+                }
+            }
+        }
+    }
+
+    class LU
+    {
+    private:
+        Matrix<> m_lu;                   // L below the diagonal (unit diagonal not stored), U on and above
+        std::vector<size_t> m_pivots;    // row i was swapped with row m_pivots[i] (in this order)
+
+    public:
+        // c'tor(s)
+        explicit LU(const Matrix<>& a) : m_lu{ a }, m_pivots(a.getRows())
+        {
+            if (a.getCols() != a.getRows()) {
+                throw std::invalid_argument("LU: matrix is not square");
+            }
+
+            const size_t n{ a.getRows() };
+
+            for (size_t col{}; col < n; col += LuBlock) {
+
+                const size_t width{ std::min(LuBlock, n - col) };
+                const size_t rest{ col + width };
+
+                LuKernel::factorizePanel(m_lu, col, width, m_pivots);
+
+                if (rest == n) {
+                    break;
+                }
+
+                const size_t colBlocks{ (n - rest + GemmNC - 1) / GemmNC };
+                const size_t rowBlocks{ (n - rest + GemmMC - 1) / GemmMC };
+
+                LuKernel::forEach(colBlocks, [&](size_t block) {
+                    const size_t first{ rest + block * GemmNC };
+                    LuKernel::solveRows(m_lu, col, width, first, std::min(first + GemmNC, n));
+                });
+
+                LuKernel::forEach(rowBlocks * colBlocks, [&](size_t block) {
+                    const size_t row{ rest + (block / colBlocks) * GemmMC };
+                    const size_t colBegin{ rest + (block % colBlocks) * GemmNC };
+                    LuKernel::updateBlock(m_lu, col, width,
+                        row, std::min(GemmMC, n - row), colBegin, std::min(GemmNC, n - colBegin));
+                });
+            }
+        }
+
+        // getter
+        const Matrix<>& factors() const { return m_lu; }
+        const std::vector<size_t>& pivots() const { return m_pivots; }
+
+        double determinant() const
+        {
+            double det{ 1.0 };
+            for (size_t i{}; i != m_pivots.size(); ++i) {
+                det *= (m_pivots[i] == i) ? m_lu(i, i) : -m_lu(i, i);
+            }
+            return det;
+        }
+
+        // solves A x = b in place: b is permuted, then L y = Pb (forward) and U x = y (backward);
+        // each step is a dot product of a row of L or U with the solved part of b
+        void solveInPlace(Vector<>& b) const
+        {
+            const size_t n{ m_pivots.size() };
+
+            if (b.size() != n) {
+                throw std::invalid_argument("LU: right-hand side has wrong size");
+            }
+
+            for (size_t i{}; i != n; ++i) {
+                std::swap(b[i], b[m_pivots[i]]);
+            }
+
+            for (size_t i{ 1 }; i < n; ++i) {
+                b[i] -= dot(block(m_lu, 0, i, i, 1), block(b, 0, 0, i, 1));
+            }
+
+            for (size_t i{ n }; i-- != 0; ) {
+                b[i] = (b[i] - dot(block(m_lu, i + 1, i, n - i - 1, 1), block(b, i + 1, 0, n - i - 1, 1))) / m_lu(i, i);
+            }
+        }
+
+        Vector<> solve(const Vector<>& b) const
+        {
+            Vector<> x{ b };
+            solveInPlace(x);
+            return x;
+        }
+    };
+
+    // textbook unblocked factorization, for comparison only
+    std::vector<size_t> luNaive(Matrix<>& a)
+    {
+        const size_t n{ a.getRows() };
+        std::vector<size_t> pivots(n);
+
+        for (size_t j{}; j != n; ++j) {
+
+            size_t pivot{ j };
+            for (size_t i{ j + 1 }; i != n; ++i) {
+                if (std::abs(a(j, i)) > std::abs(a(j, pivot))) {
+                    pivot = i;
+                }
+            }
+
+            pivots[j] = pivot;
+            for (size_t x{}; x != n; ++x) {
+                std::swap(a(x, j), a(x, pivot));
+            }
+
+            for (size_t i{ j + 1 }; i != n; ++i) {
+                a(j, i) /= a(j, j);
+                for (size_t x{ j + 1 }; x != n; ++x) {
+                    a(x, i) -= a(j, i) * a(x, j);
+                }
+            }
+        }
+        return pivots;
+    }
+
+    // ========================================================================
+    // sparse matrix in CSR format (compressed sparse row): only the non-zeros
+    // are stored, row after row, together with their column index
+
+    class SparseMatrix
+    {
+    public:
+        struct Triplet
+        {
+            size_t m_x;
+            size_t m_y;
+            double m_value;
+        };
+
+    private:
+        size_t m_cols;
+        size_t m_rows;
+        std::vector<double> m_values;      // non-zeros, row after row
+        std::vector<size_t> m_columns;     // column of each non-zero
+        std::vector<size_t> m_rowStarts;   // first non-zero of each row (rows + 1 entries)
+
+    public:
+        using value_type = double;
+
+        static constexpr bool IsLinear{ false };
+
+        // c'tor(s) - duplicate triplets are summed up
+        SparseMatrix(size_t cols, size_t rows) : SparseMatrix{ cols, rows, {} } {}
+
+        SparseMatrix(size_t cols, size_t rows, std::vector<Triplet> triplets)
+            : m_cols{ cols }, m_rows{ rows }, m_rowStarts(rows + 1)
+        {
+            std::sort(
+                std::begin(triplets),
+                std::end(triplets),
+                [](const Triplet& a, const Triplet& b) {
+                    return std::tie(a.m_y, a.m_x) < std::tie(b.m_y, b.m_x);
+                }
+            );
+
+            for (const Triplet& triplet : triplets) {
+
+                if (triplet.m_x >= cols || triplet.m_y >= rows) {
+                    throw std::out_of_range("SparseMatrix: triplet outside of the matrix");
+                }
+
+                const bool duplicate{
+                    !m_columns.empty() &&
+                    m_rowStarts[triplet.m_y + 1] != 0 &&
+                    m_columns.back() == triplet.m_x
+                };
+
+                if (duplicate) {
+                    m_values.back() += triplet.m_value;
+                }
+                else {
+                    m_values.push_back(triplet.m_value);
+                    m_columns.push_back(triplet.m_x);
+                    ++m_rowStarts[triplet.m_y + 1];
+                }
+            }
+
+            std::partial_sum(std::begin(m_rowStarts), std::end(m_rowStarts), std::begin(m_rowStarts));
+        }
+
+        // getter
+        size_t getCols() const { return m_cols; }
+        size_t getRows() const { return m_rows; }
+        size_t getNonZeros() const { return m_values.size(); }
+
+        template <typename U, typename S>
+        bool reads(const Matrix<U, S>&) const { return false; }
+
+        template <typename U, typename S>
+        bool aliases(const Matrix<U, S>&) const { return false; }
+
+        // per element: the non-zeros with their column index, spread over all elements
+        void addCost(ExprCost& cost) const {
+            ++cost.m_nodes;
+            cost.m_bytesRead += static_cast<double>(getNonZeros() * (sizeof(double) + sizeof(size_t))) /
+                static_cast<double>(std::max<size_t>(m_cols * m_rows, 1));
+        }
+
+        // random access: binary search within the row
+        double operator() (size_t x, size_t y) const {
+            auto first{ std::begin(m_columns) + m_rowStarts[y] };
+            auto last{ std::begin(m_columns) + m_rowStarts[y + 1] };
+            auto pos{ std::lower_bound(first, last, x) };
+            return (pos != last && *pos == x) ? m_values[pos - std::begin(m_columns)] : 0.0;
+        }
+
+        Packet<double> eval(size_t x, size_t y) const {
+            return makePacket<double>([&](size_t k) { return (*this)(x + k, y); });
+        }
+
+        // visits the non-zeros only: func(x, y, value)
+        template <typename TFunc>
+        void forEachNonZero(TFunc func) const {
+            for (size_t y{}; y != m_rows; ++y) {
+                for (size_t k{ m_rowStarts[y] }; k != m_rowStarts[y + 1]; ++k) {
+                    func(m_columns[k], y, m_values[k]);
+                }
+            }
+        }
+
+        // y = this * x
+        void multiply(std::span<const double> x, std::span<double> y) const {
+
+            if (x.size() != m_cols || y.size() != m_rows) {
+                throw std::invalid_argument("SparseMatrix: vector sizes do not match");
+            }
+
+            for (size_t row{}; row != m_rows; ++row) {
+                double sum{};
+                for (size_t k{ m_rowStarts[row] }; k != m_rowStarts[row + 1]; ++k) {
+                    sum += m_values[k] * x[m_columns[k]];
+                }
+                y[row] = sum;
+            }
+        }
+    };
+
+    template <>
+    constexpr bool StoreByReference<SparseMatrix>{ true };
+
+    template <>
+    constexpr bool IsSparse<SparseMatrix>{ true };
+
+    // sparse matrix times dense vector
+    inline std::vector<double> operator*(const SparseMatrix& sparse, std::span<const double> x)
+    {
+        std::vector<double> y(sparse.getRows());
+        sparse.multiply(x, y);
+        return y;
+    }
+
+    // scaled sparse matrix - scaling costs nothing until the term is scattered
+    class SparseTerm
+    {
+    private:
+        const SparseMatrix& m_sparse;
+        double m_scale;
+
+    public:
+        SparseTerm(const SparseMatrix& sparse) : SparseTerm{ sparse, 1.0 } {}
+        SparseTerm(const SparseMatrix& sparse, double scale) : m_sparse{ sparse }, m_scale{ scale } {}
+
+        const SparseMatrix& sparse() const { return m_sparse; }
+        double scale() const { return m_scale; }
+
+        // target += scale * sparse, visiting the non-zeros only
+        template <typename T, typename TStorage>
+        void scatter(Matrix<T, TStorage>& target) const {
+            m_sparse.forEachNonZero([&](size_t x, size_t y, double value) {
+                target(x, y) += static_cast<T>(m_scale * value);
+            });
+        }
+    };
+
+    inline SparseTerm operator*(double scale, const SparseMatrix& sparse) { return { sparse, scale }; }
+    inline SparseTerm operator*(const SparseMatrix& sparse, double scale) { return { sparse, scale }; }
+    inline SparseTerm operator/(const SparseMatrix& sparse, double scale) { return { sparse, 1.0 / scale }; }
+    inline SparseTerm operator*(double scale, const SparseTerm& term) { return { term.sparse(), scale * term.scale() }; }
+    inline SparseTerm operator*(const SparseTerm& term, double scale) { return { term.sparse(), scale * term.scale() }; }
+    inline SparseTerm operator-(const SparseMatrix& sparse) { return { sparse, -1.0 }; }
+    inline SparseTerm operator-(const SparseTerm& term) { return { term.sparse(), -term.scale() }; }
+
+    // dense expression plus sparse terms: the dense part is evaluated as usual
+    // (fused, SIMD, parallel), then the non-zeros of each term are added
+    template <typename TExpr>
+    class SparseSum
+    {
+    private:
+        ExprStorage<TExpr> m_dense;
+        std::vector<SparseTerm> m_terms;
+
+    public:
+        SparseSum(const TExpr& dense, std::vector<SparseTerm> terms)
+            : m_dense{ dense }, m_terms{ std::move(terms) }
+        {
+            for (const auto& term : m_terms) {
+                if (dense.getCols() != 0 && (term.sparse().getCols() != dense.getCols() || term.sparse().getRows() != dense.getRows())) {
+                    throw std::invalid_argument("SparseSum: sparse and dense operands differ in size");
+                }
+            }
+        }
+
+        const TExpr& dense() const { return m_dense; }
+        const std::vector<SparseTerm>& terms() const { return m_terms; }
+    };
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator+(const TExpr& dense, const SparseTerm& term) {
+        return SparseSum<TExpr>(dense, { term });
+    }
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator+(const SparseTerm& term, const TExpr& dense) {
+        return SparseSum<TExpr>(dense, { term });
+    }
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator-(const TExpr& dense, const SparseTerm& term) {
+        return SparseSum<TExpr>(dense, { -term });
+    }
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator+(const TExpr& dense, const SparseMatrix& sparse) {
+        return dense + SparseTerm{ sparse, 1.0 };
+    }
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator+(const SparseMatrix& sparse, const TExpr& dense) {
+        return dense + SparseTerm{ sparse, 1.0 };
+    }
+
+    template <DenseExpression TExpr>
+    SparseSum<TExpr> operator-(const TExpr& dense, const SparseMatrix& sparse) {
+        return dense + SparseTerm{ sparse, -1.0 };
+    }
+
+    // sparse operands only, e.g. 's + s' or '2.0 * s - t': scattered onto zeros
+    inline SparseSum<Scalar<>> operator+(const SparseTerm& lhs, const SparseTerm& rhs) {
+        return SparseSum<Scalar<>>(Scalar{ 0.0 }, { lhs, rhs });
+    }
+
+    inline SparseSum<Scalar<>> operator-(const SparseTerm& lhs, const SparseTerm& rhs) {
+        return SparseSum<Scalar<>>(Scalar{ 0.0 }, { lhs, -rhs });
+    }
+
+    template <typename TExpr>
+    SparseSum<TExpr> operator+(const SparseSum<TExpr>& sum, const SparseTerm& term) {
+        std::vector<SparseTerm> terms{ sum.terms() };
+        terms.push_back(term);
+        return SparseSum<TExpr>(sum.dense(), std::move(terms));
+    }
+
+    template <typename TExpr>
+    SparseSum<TExpr> operator+(const SparseSum<TExpr>& sum, const SparseMatrix& sparse) {
+        return sum + SparseTerm{ sparse, 1.0 };
+    }
+
+    template <typename T, typename TStorage>
+    template <typename TExpr>
+    Matrix<T, TStorage>& Matrix<T, TStorage>::operator=(const SparseSum<TExpr>& expr) {
+
+        *this = expr.dense();
+
+        for (const auto& term : expr.terms()) {
+            term.scatter(*this);
+        }
+        return *this;
+    }
+
+    template <typename T, typename TStorage>
+    Matrix<T, TStorage>& Matrix<T, TStorage>::operator=(const SparseTerm& term) {
+
+        *this = Scalar<T>{ T{} };
+        term.scatter(*this);
+        return *this;
+    }
+
+    // ========================================================================
+
+    static void test_01()
+    {
+        std::cout << "Expression Template 01: Classical Approach" << std::endl;
+
+        ClassicalMatrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
+        ClassicalMatrix result = a + b + c + d;  // result(x, y) = 10 
+    }
+
+    static void test_02()
+    {
+        std::cout << "Expression Template 02:" << std::endl;
+
+        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
+        Matrix result{};
+
+        // adding 2 matrices
+        MatrixExpr<Matrix<>, Matrix<>> sumAB(a, b);
+        for (size_t y = 0; y != a.getRows(); ++y) {
+            for (size_t x = 0; x != a.getCols(); ++x) {
+                result(x, y) = sumAB(x, y);
+            }
+        }
+
+        // adding 3 matrices
+        MatrixExpr<MatrixExpr<Matrix<>, Matrix<>>, Matrix<>> sumABC(sumAB, c);
+        for (size_t y = 0; y != a.getRows(); ++y) {
+            for (size_t x = 0; x != a.getCols(); ++x) {
+                result(x, y) = sumABC(x, y);
+            }
+        }
+
+        // adding 4 matrices
+        MatrixExpr<MatrixExpr<MatrixExpr<Matrix<>, Matrix<>>, Matrix<>>, Matrix<>> sumABCD{ sumABC, d };
+        for (size_t y = 0; y != a.getRows(); ++y) {
+            for (size_t x = 0; x != a.getCols(); ++x) {
+                result(x, y) = sumABCD(x, y);
+            }
+        }
+    }
+
+    static void test_03()
+    {
+        std::cout << "Expression Template 03: Expression Templates Approach" << std::endl;
+
+        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
+        Matrix result{};
+
+        // adding 4 matrices using modified operator=
+        // MatrixExpr<Matrix<>, Matrix<>> sumAB{ a, b };
+        // MatrixExpr<MatrixExpr<Matrix<>, Matrix<>>, Matrix<>> sumABC{ sumAB, c };
+        // MatrixExpr<MatrixExpr<MatrixExpr<Matrix<>, Matrix<>>, Matrix<>>, Matrix<>> sumABCD{ sumABC, d };
+
+        // or - using template argument type deduction:
+        MatrixExpr sumAB{ a, b };
+        MatrixExpr sumABC{ sumAB, c };
+        MatrixExpr sumABCD{ sumABC, d };
+
+        result = sumABCD;
+    }
+
+    static void test_05()
+    {
+        std::cout << "Expression Template 05: Fused Operator Algebra" << std::endl;
+
+        Matrix a{ 5.0 }, b{ 1.0 }, c{ 3.0 }, d{ 16.0 };
+        Matrix result{};
+
+        // one single pass, no temporary Matrix objects
+        result = 0.5 * hadamard(a - b, c) + sqrt(d);   // result(x, y) = 10
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;
+
+        result = -abs(b - a) / 2.0 + exp(b - b);        // result(x, y) = -1
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;
+    }
+
+    static void test_07()
+    {
+        std::cout << "Expression Template 07: Reductions" << std::endl;
+
+        Matrix a{ 7, 5 }, b{ 7, 5 };
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != a.getCols(); ++x) {
+                a(x, y) = static_cast<double>(x + y);
+                b(x, y) = 2.0;
+            }
+        }
+
+        // each of them is one pass over 'a' and 'b', no temporary Matrix objects
+        std::cout << "sum(a - b)     = " << sum(a - b) << std::endl;       // 105
+        std::cout << "dot(a, b)      = " << dot(a, b) << std::endl;        // 350
+        std::cout << "norm2(b)       = " << norm2(b) << std::endl;         // 11.8322
+        std::cout << "min(a - 3.0*b) = " << min(a - 3.0 * b) << std::endl; // -6
+        std::cout << "max(a - 3.0*b) = " << max(a - 3.0 * b) << std::endl; // 4
+    }
+
+    static void test_08()
+    {
+        std::cout << "Expression Template 08: Views" << std::endl;
+
+        Matrix big{ 1000, 1000 };
+        for (size_t y{}; y != big.getRows(); ++y) {
+            for (size_t x{}; x != big.getCols(); ++x) {
+                big(x, y) = static_cast<double>(1000 * y + x);
+            }
+        }
+
+        // only the 100 x 100 elements of the block are read
+        Matrix result{ 100, 100 };
+        result = block(big, 200, 300, 100, 100) - transpose(block(big, 300, 200, 100, 100));
+        std::cout << "result(1, 0) = " << result(1, 0) << std::endl;     // 98901
+
+        // every 100th element of every 100th row
+        Matrix sample{ 10, 10 };
+        sample = strided(big, 0, 0, 10, 10, 100, 100);
+        std::cout << "sample(2, 3) = " << sample(2, 3) << std::endl;     // 300200
+
+        std::cout << "sum(column(big, 999)) = " << sum(column(big, 999)) << std::endl;  // 500499000
+    }
+
+    static void test_09()
+    {
+        std::cout << "Expression Template 09: Deferred Evaluation" << std::endl;
+
+        Matrix u{ 1.0 }, v{ 2.0 }, w{}, r{};
+
+        {
+            DeferredEvaluation scope;
+            scope.assign(w, 0.5 * (u - v));       // w(x, y) = -0.5
+            scope.assign(u, u + 0.1 * w);         // reads w element-wise: same pass
+            scope.assign(r, transpose(w) - u);    // reads w transposed: second pass
+            scope.execute();
+
+            std::cout << "passes: " << scope.getPasses() << std::endl;  // 2
+
+            scope.assign(v, Scalar{ 1.0 });       // no size: fits any target
+        }
+
+        std::cout << "u(0, 0) = " << u(0, 0) << std::endl;   // 0.95
+        std::cout << "r(0, 0) = " << r(0, 0) << std::endl;   // -1.45
+        std::cout << "v(0, 0) = " << v(0, 0) << std::endl;   // 1
+    }
+
+    static void test_10()
+    {
+        std::cout << "Expression Template 10: Sparse Matrices (CSR)" << std::endl;
+
+        // tridiagonal matrix: 3 non-zeros per row
+        std::vector<SparseMatrix::Triplet> triplets;
+        for (size_t i{}; i != Rows; ++i) {
+            triplets.push_back({ i, i, 2.0 });
+            if (i != 0) {
+                triplets.push_back({ i - 1, i, -1.0 });
+            }
+            if (i + 1 != Rows) {
+                triplets.push_back({ i + 1, i, -1.0 });
+            }
+        }
+
+        SparseMatrix s{ Cols, Rows, std::move(triplets) };
+        std::cout << "non-zeros: " << s.getNonZeros() << std::endl;
+
+        Matrix a{ 1.0 }, b{ 3.0 }, result{};
+
+        // dense part in one fused pass, then 'nnz' updates only
+        result = 0.5 * (b - a) + 2.0 * s;
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;    // 5
+        std::cout << "result(1, 0) = " << result(1, 0) << std::endl;    // -1
+        std::cout << "result(2, 0) = " << result(2, 0) << std::endl;    // 1
+
+        // sparse operands only: scattered onto zeros
+        result = s + s;
+        std::cout << "result(0, 0) = " << result(0, 0) << std::endl;    // 4
+        std::cout << "result(1, 0) = " << result(1, 0) << std::endl;    // -2
+
+        result = 2.0 * s;
+        std::cout << "result(1, 1) = " << result(1, 1) << std::endl;    // 4
+        std::cout << "result(2, 0) = " << result(2, 0) << std::endl;    // 0
+
+        std::vector<double> x(Cols, 1.0);
+        std::vector<double> y{ s * x };
+        std::cout << "y[0] = " << y[0] << ", y[1] = " << y[1] << std::endl;   // 1, 0
+    }
+
+    static void test_11()
+    {
+        std::cout << "Expression Template 11: Element Types" << std::endl;
+
+        Matrix<double> d{ 0.25 };
+        Matrix<float> f{ 1.5f };
+        Matrix<std::int32_t> i{ 2 };
+        Matrix<std::int16_t> s{ 3 };
+
+        // int16_t * int32_t => int32_t
+        Matrix<std::int32_t> ri{};
+        ri = hadamard(s, i) + i;
+        std::cout << "ri(0, 0) = " << ri(0, 0) << std::endl;    // 8
+
+        // float - int32_t => float, the scalar is a float, too
+        Matrix<float> rf{};
+        rf = 2.0f * f - i;
+        std::cout << "rf(0, 0) = " << rf(0, 0) << std::endl;    // 1
+
+        // float + double => double
+        Matrix<double> rd{};
+        rd = f + d;
+        std::cout << "rd(0, 0) = " << rd(0, 0) << std::endl;    // 1.75
+
+        // the result is converted to the element type of the target
+        Matrix<std::int16_t> rs{};
+        rs = f + d;
+        std::cout << "rs(0, 0) = " << rs(0, 0) << std::endl;    // 1
+
+        std::cout << "max(s - i) = " << max(s - i) << std::endl;   // 1
+    }
+
+    static void test_12()
+    {
+        std::cout << "Expression Template 12: Aligned, Padded Storage" << std::endl;
+
+        Matrix<> a{ 1024, 4, RowPadding::CacheLine }, b{ 1024, 4 };
+        Matrix<> result{ 1024, 4, RowPadding::CacheLine };
+
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != a.getCols(); ++x) {
+                a(x, y) = static_cast<double>(x);
+                b(x, y) = static_cast<double>(y);
+            }
+        }
+
+        std::cout << "stride(a) = " << a.getStride() << ", stride(b) = " << b.getStride() << std::endl;  // 1032, 1024
+        std::cout << "aligned:  " << std::boolalpha
+            << (reinterpret_cast<std::uintptr_t>(a.data()) % CacheLine == 0) << std::endl;             // true
+
+        // same strides: linear, aligned loads and stores
+        result = a + a;
+        std::cout << "result(1023, 3) = " << result(1023, 3) << std::endl;    // 2046
+
+        // different strides: row by row
+        result = a + 2.0 * b;
+        std::cout << "result(1023, 3) = " << result(1023, 3) << std::endl;    // 1029
+
+        // copy assignment takes size and stride along
+        Matrix<> copy{ 3, 3 };
+        copy = a;
+        std::cout << copy.getCols() << 'x' << copy.getRows() << ", stride " << copy.getStride() << std::endl;  // 1024x4, stride 1032
+    }
+
+    // file in the temp directory with a name of its own (concurrent runs do not
+    // collide), removed when going out of scope - also if an exception is thrown
+    class TemporaryFile
+    {
+    private:
+        std::filesystem::path m_path;
+
+    public:
+        explicit TemporaryFile(const std::string& stem)
+        {
+            static std::atomic<size_t> counter{};
+
+            const auto ticks{ std::chrono::steady_clock::now().time_since_epoch().count() };
+            const std::string name{
+                stem + '_' + std::to_string(std::random_device{}()) + '_' +
+                std::to_string(ticks) + '_' + std::to_string(counter++) + ".bin"
+            };
+            m_path = std::filesystem::temp_directory_path() / name;
+        }
+
+        ~TemporaryFile()
+        {
+            std::error_code error{};
+            std::filesystem::remove(m_path, error);
+        }
+
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+        const std::filesystem::path& path() const { return m_path; }
+    };
+
+    static void test_13()
+    {
+        std::cout << "Expression Template 13: Out-of-Core Matrices (Memory-Mapped Files)" << std::endl;
+
+        constexpr size_t cols{ 1024 };
+        constexpr size_t rows{ 1280 };   // 10 MB per matrix: two chunks of StreamingBytes
+
+        const TemporaryFile files[]{ TemporaryFile{ "et_a" }, TemporaryFile{ "et_b" }, TemporaryFile{ "et_c" }, TemporaryFile{ "et_result" } };
+
+        MappedMatrix<> a{ cols, rows, MappedStorage<double>{ files[0].path() } };
+        MappedMatrix<> b{ cols, rows, MappedStorage<double>{ files[1].path() } };
+        MappedMatrix<> c{ cols, rows, MappedStorage<double>{ files[2].path() } };
+        MappedMatrix<> result{ cols, rows, MappedStorage<double>{ files[3].path() } };
+
+        a = Scalar{ 1.0 };
+        b = Scalar{ 2.0 };
+        c = Scalar{ 3.0 };
+
+        // streamed chunk by chunk, finished chunks leave the resident memory
+        result = a + b + c;
+        std::cout << "result(1023, 1279) = " << result(cols - 1, rows - 1) << std::endl;  // 6
+        std::cout << "sum(result) = " << sum(result) << std::endl;                        // 7.86432e+06
+    }
+
+    static void test_14()
+    {
+        std::cout << "Expression Template 14: Binary Matrix Files" << std::endl;
+
+        const TemporaryFile temporary{ "et_matrix" };
+        const std::filesystem::path& file{ temporary.path() };
+
+        {
+            Matrix<> a{ 1023, 500, RowPadding::CacheLine };
+            for (size_t y{}; y != a.getRows(); ++y) {
+                for (size_t x{}; x != a.getCols(); ++x) {
+                    a(x, y) = static_cast<double>(x + y);
+                }
+            }
+
+            writeMatrix(file, a);
+        }
+
+        // zero-copy: the elements are read straight from the mapped file
+        MappedMatrix<> view{ mapMatrix(file) };
+        std::cout << "view: " << view.getCols() << " x " << view.getRows()
+            << ", stride " << view.getStride() << std::endl;                          // 1023 x 500, stride 1032
+        std::cout << "view(1022, 499) = " << view(1022, 499) << std::endl;           // 1521
+
+        // bulk read into an owned matrix
+        Matrix<> copy{ readMatrix(file) };
+
+        Matrix<> result{ 1023, 500, RowPadding::CacheLine };
+        result = view + 2.0 * copy;
+        std::cout << "result(1022, 499) = " << result(1022, 499) << std::endl;       // 4563
+    }
+
+    static void test_15()
+    {
+        std::cout << "Expression Template 15: Aliasing-Aware Assignment" << std::endl;
+
+        Matrix a{ 500, 500 };
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != a.getCols(); ++x) {
+                a(x, y) = static_cast<double>(1000 * y + x);
+            }
+        }
+
+        // element-wise: evaluated in place, no temporary
+        std::cout << std::boolalpha << "aliases: " << (2.0 * a + a).aliases(a) << std::endl;     // false
+        a = 2.0 * a + a;
+        std::cout << "a(1, 2) = " << a(1, 2) << std::endl;                                        // 6003
+
+        // element (x, y) reads (y, x): evaluated into a temporary
+        std::cout << "aliases: " << (a + transpose(a)).aliases(a) << std::endl;                   // true
+        a = transpose(a);
+        std::cout << "a(1, 2) = " << a(1, 2) << std::endl;                                        // 3006
+        std::cout << "a(2, 1) = " << a(2, 1) << std::endl;                                        // 6003
+
+        // deferred: the transposition runs after the pending statement, on its own
+        Matrix b{ 500, 500 };
+        {
+            DeferredEvaluation scope;
+            scope.assign(b, 1.0 * a);
+            scope.assign(a, transpose(a) - b);
+        }
+        std::cout << "a(1, 2) = " << a(1, 2) << std::endl;                                        // 2997
+    }
+
+    static void test_16()
+    {
+        std::cout << "Expression Template 16: Common Subexpressions" << std::endl;
+
+        Matrix a{ 1000, 1000 }, b{ 1000, 1000 }, c{ 1000, 1000 }, d{ 1000, 1000 };
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != a.getCols(); ++x) {
+                a(x, y) = static_cast<double>(x % 10) * 0.1;
+                b(x, y) = static_cast<double>(y % 10);
+                c(x, y) = 2.0;
+                d(x, y) = 3.0;
+            }
+        }
+
+        Matrix plain{ 1000, 1000 }, cached{ 1000, 1000 };
+
+        // 'exp(a) + sqrt(b)' evaluated three times per element
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; ++i) {
+            plain = hadamard(exp(a) + sqrt(b), c) + hadamard(exp(a) + sqrt(b), d) - (exp(a) + sqrt(b));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "recomputed: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+            << " microseconds." << std::endl;
+
+        // ... once per element, the other consumers read the cache
+        const auto s{ shared(exp(a) + sqrt(b)) };
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; ++i) {
+            cached = hadamard(s, c) + hadamard(s, d) - s;
+        }
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "shared:     "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+            << " microseconds." << std::endl;
+
+        std::cout << "max. deviation: " << max(abs(cached - plain)) << std::endl;   // ~1e-15
+        std::cout << "sum(s) = " << sum(s) << std::endl;                                  // 3.5644e+06
+
+        // a sum of plain matrices is a lightweight node as well: 's' only refers to 'a' and 'b'
+        const auto t{ shared(a + b) };
+        cached = hadamard(t, c) + hadamard(t, d);
+        plain = hadamard(a + b, c) + hadamard(a + b, d);
+        std::cout << "max. deviation: " << max(abs(cached - plain)) << std::endl;   // ~1e-15
+
+        // more shared nodes than cache slots: the surplus ones are evaluated directly
+        const auto s1{ shared(a + b) }, s2{ shared(a + c) }, s3{ shared(a + d) },
+            s4{ shared(b + c) }, s5{ shared(b + d) };
+        cached = hadamard(s1, c) + hadamard(s5, c) + s1 + s5 + s2 + s3 + s4;
+        plain = hadamard(a + b, c) + hadamard(b + d, c) + (a + b) + (b + d) + (a + c) + (a + d) + (b + c);
+        std::cout << "max. deviation: " << max(abs(cached - plain)) << std::endl;   // ~1e-15
+    }
+
+    static void test_17()
+    {
+        std::cout << "Expression Template 17: Stencils" << std::endl;
+
+        Matrix small{ 4, 3 };
+        for (size_t y{}; y != small.getRows(); ++y) {
+            for (size_t x{}; x != small.getCols(); ++x) {
+                small(x, y) = static_cast<double>(4 * y + x);
+            }
+        }
+
+        const Stencil<> left{ { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 0 } };   // reads the left neighbour
+        Matrix shifted{ 4, 3 };
+        for (Boundary boundary : { Boundary::Zero, Boundary::Clamp, Boundary::Wrap, Boundary::Mirror }) {
+            shifted = stencil(small, left, boundary);
+            std::cout << "row 1:";
+            for (size_t x{}; x != shifted.getCols(); ++x) {
+                std::cout << ' ' << shifted(x, 1);          // 0 4 5 6 | 4 4 5 6 | 7 4 5 6 | 5 4 5 6
+            }
+            std::cout << std::endl;
+        }
+
+        // one explicit Euler step of the heat equation, fused with the addition
+        Matrix grid{ 1000, 1000 }, next{ 1000, 1000 };
+        for (size_t y{}; y != grid.getRows(); ++y) {
+            for (size_t x{}; x != grid.getCols(); ++x) {
+                grid(x, y) = static_cast<double>((x * 7 + y * 3) % 11);
+            }
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; ++i) {
+            next = grid + 0.1 * stencil(grid, Stencil<>::laplacian(), Boundary::Clamp);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "heat step (1000 x 1000): "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / Iterations
+            << " microseconds." << std::endl;
+
+        // scalar reference: element by element
+        double deviation{};
+        const auto laplace{ stencil(grid, Stencil<>::laplacian(), Boundary::Clamp) };
+        for (size_t y{}; y != grid.getRows(); ++y) {
+            for (size_t x{}; x != grid.getCols(); ++x) {
+                deviation = std::max(deviation, std::abs(next(x, y) - grid(x, y) - 0.1 * laplace(x, y)));
+            }
+        }
+        std::cout << "max. deviation: " << deviation << std::endl;                         // ~1e-16
 
-    class Matrix {
-    private:
-        size_t m_cols;
-        size_t m_rows;
-        std::vector<double> m_values;
+        // 5 x 5 box blur of an expression: 'grid + grid' is evaluated once per band element
+        Matrix blurred{ 1000, 1000 };
+        blurred = convolve(grid + grid, Stencil<>::box(2), Boundary::Mirror);
+        std::cout << "sum(blurred) / sum(grid) = " << sum(blurred) / sum(grid) << std::endl;  // ~2
 
-    public:
-        // c'tor(s)
-        Matrix() : Matrix(Cols, Rows) {}
+        // kept for later: the stencil node refers to 'grid' and 'next' only
+        const auto smoothed{ stencil(grid + next, Stencil<>::box(1), Boundary::Clamp) };
+        blurred = smoothed;
+        std::cout << "blurred(500, 500) = " << blurred(500, 500) << std::endl;    // 11.7556
+    }
 
-        Matrix(size_t cols, size_t rows) : m_cols{ cols }, m_rows{ rows }
-        {
-            m_values.resize(cols*rows);
-        }
+    static void test_18()
+    {
+        std::cout << "Expression Template 18: Instrumentation" << std::endl;
 
-        Matrix(double fill) : Matrix(Cols, Rows)
-        {
-            std::fill(
-                std::begin(m_values),
-                std::end(m_values),
-                fill
-            );
+        if constexpr (!Instrumented) {
+            std::cout << "disabled - set 'Instrumented' to true" << std::endl;
         }
 
-        // getter
-        size_t inline getCols() const { return m_cols; };
-        size_t inline getRows() const { return m_rows; };
+        Matrix a{ 1000, 1000 }, b{ 1000, 1000 }, c{ 1000, 1000 }, result{ 1000, 1000 };
+        a = Scalar{ 1.0 };
+        b = Scalar{ 2.0 };
+        c = Scalar{ 3.0 };
 
-        // functor - representing index operator
-        const double& operator()(size_t x, size_t y) const;
-        double& operator()(size_t x, size_t y);
+        Instrumentation::instance().clear();
 
-        // operator= --> classical definition
-        Matrix& operator=(const Matrix& rhs);
+        result = hadamard(a, b) + c;                     // 5 nodes, 2e+06 flops, 2.4e+07 bytes read
+        result = 0.5 * hadamard(a - b, c) + sqrt(a);     // 10 nodes
+        result = stencil(a, Stencil<>::laplacian());     // 2 nodes, 18 flops per element
 
-        // operator= --> expression template approach (template member method)
-        template <typename TExpr>
-        Matrix& operator=(const TExpr& expression);
-    };
+        // query API
+        for (const auto& report : Instrumentation::instance().reports()) {
+            std::cout << report.m_nodes << " nodes, " << report.gigabytesPerSecond() << " GB/s, "
+                << report.gigaflopsPerSecond() << " GFLOP/s" << std::endl;
+        }
 
-    const double& Matrix::operator()(size_t x, size_t y) const {
-        //if constexpr (Verbose) {
-        //    std::cout << "Matrix::operator() => [" << x << ',' << y << ']' << std::endl;
-        //}
-        return m_values[y * getCols() + x];
+        // or: Instrumentation::instance().setDumpInterval(std::chrono::seconds{ 1 });
+        Instrumentation::instance().dump(std::cout);
     }
 
-    double& Matrix::operator()(size_t x, size_t y) {
-        //if constexpr (Verbose) {
-        //    std::cout << "Matrix::operator() => [" << x << ',' << y << ']' << std::endl;
-        //}
-        return m_values[y * getCols() + x];
+    static void test_19()
+    {
+        std::cout << "Expression Template 19: Vectors and BLAS Level 1" << std::endl;
+
+        Vector<> x{ 1.0, 2.0, 3.0, 4.0, 5.0 };
+        Vector<> y(5, 1.0);
+        Vector<> w(5);
+
+        axpy(2.0, x, y);                  // y = 2x + 1
+        std::cout << "y[4] = " << y[4] << std::endl;                          // 11
+
+        scal(0.5, y);                     // y = x + 0.5
+        std::cout << "y[4] = " << y[4] << std::endl;                          // 5.5
+
+        waxpby(1.0, x, -1.0, y, w);       // w = -0.5
+        std::cout << "w[0] = " << w[0] << std::endl;                          // -0.5
+
+        std::cout << "dot(x, y) = " << dot(x, y) << std::endl;                // 62.5
+        std::cout << "nrm2(x)   = " << nrm2(x) << std::endl;                  // 7.4162
+
+        // any expression: y = 3 * (x - w) + y
+        axpy(3.0, x - w, y);
+        std::cout << "y[0] = " << y[0] << std::endl;                          // 6
     }
 
-    // classical operator+ definition
-    Matrix operator+(const Matrix& lhs, const Matrix& rhs)
+    static void test_20()
     {
-        Matrix result{ lhs.getCols(), lhs.getRows() };
+        std::cout << "Expression Template 20: Masked Selection" << std::endl;
 
-        for (size_t y{}; y != lhs.getRows(); ++y) {
-            for (size_t x{}; x != lhs.getCols(); ++x) {
-
-                if constexpr (Verbose) {
-                    double l {lhs(x, y)};
-                    double r {rhs(x, y)};
-                    std::cout << "Matrix:: adding " << l << '+' << r << std::endl;
-                    double tmp{ l + r };
-                    std::cout << "Matrix:: assigning result " << tmp << std::endl;
-                    result(x, y) = tmp;
-                }
-                else {
-                    result(x, y) = lhs(x, y) + rhs(x, y);
-                }
+        // odd sizes: full packets and a scalar remainder in each row
+        Matrix a{ 1003, 7 }, b{ 1003, 7 }, r{ 1003, 7 };
+        for (size_t y{}; y != a.getRows(); ++y) {
+            for (size_t x{}; x != a.getCols(); ++x) {
+                a(x, y) = static_cast<double>((x + y) % 10);
             }
         }
-        return result;
-    }
+        b = Scalar{ 5.0 };
 
-    // classical operator= implementation
-    Matrix& Matrix::operator=(const Matrix& rhs) {
+        r = where(a > b, a - b, 0);                      // thresholding
+        std::cout << "sum(r) = " << sum(r) << std::endl;                      // 7010
 
-        // prevent self-assignment
-        if (this != &rhs) {
-            m_values = rhs.m_values;
-        }
+        r = where(a < 2.0, 2.0, where(a > 7.0, 7.0, a)); // clamping to [2, 7]
+        std::cout << "min(r) = " << min(r) << ", max(r) = " << max(r) << std::endl;   // 2, 7
 
-        return *this;
-    }
+        // a comparison as a value is 1 or 0
+        std::cout << "count(a > b) = " << sum(a > b) << std::endl;            // 2806
 
-    // expression template approach: operator=
-    template <typename TExpr>
-    Matrix& Matrix::operator=(const TExpr& expr) {
-        for (size_t y{}; y != getRows(); ++y) {
-            for (size_t x{}; x != getCols(); ++x) {
+        // row by row: the condition is read through a transposed view
+        Matrix t{ 7, 1003 };
+        t = transpose(a);
+        r = where(transpose(t) >= 5.0, a, -a);
+        std::cout << "sum(r) = " << sum(r) << std::endl;                      // 17526
 
-                if constexpr (Verbose) {
-                    double sum{ expr(x, y) };
-                    std::cout << "Matrix::    assigning expression result " << sum << std::endl;
-                    m_values[y * getCols() + x] = sum;
-                }
-                else {
-                    m_values[y * getCols() + x] = expr(x, y);
+        // unpredictable condition: the loop below branches (unless the compiler if-converts it)
+        Matrix noise{ 1000, 1000 }, out{ 1000, 1000 };
+        for (size_t y{}; y != noise.getRows(); ++y) {
+            for (size_t x{}; x != noise.getCols(); ++x) {
+                noise(x, y) = static_cast<double>(((x * 2654435761u + y * 40503u) >> 7) % 100);
+            }
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; ++i) {
+            for (size_t y{}; y != noise.getRows(); ++y) {
+                for (size_t x{}; x != noise.getCols(); ++x) {
+                    if (noise(x, y) > 50.0) {
+                        out(x, y) = noise(x, y) - 50.0;
+                    }
+                    else {
+                        out(x, y) = 0.0;
+                    }
                 }
             }
         }
-        return *this;
-    }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "branch: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / Iterations
+            << " microseconds." << std::endl;
+        const double expected{ sum(out) };
 
-    // ========================================================================
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; ++i) {
+            out = where(noise > 50.0, noise - Scalar{ 50.0 }, 0);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "where:  "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / Iterations
+            << " microseconds." << std::endl;
+        std::cout << "deviation: " << sum(out) - expected << std::endl;       // 0
+    }
 
-    Matrix add3(const Matrix& a, const Matrix& b, const Matrix& c)
+    // pseudo-random elements in [-0.5, 0.5): a regular matrix, which needs pivoting
+    // (the raw output of std::mt19937 is the same on every platform)
+    static Matrix<> test_21_matrix(size_t n)
     {
-        Matrix result{ a.getCols(), a.getRows() };
-        for (size_t y = 0; y != a.getRows(); ++y) {
-            for (size_t x = 0; x != a.getCols(); ++x) {
-                result(x, y) = a(x, y) + b(x, y) + c(x, y);
+        std::mt19937 generator{ 42 };
+
+        Matrix a{ n, n };
+        for (size_t y{}; y != n; ++y) {
+            for (size_t x{}; x != n; ++x) {
+                a(x, y) = static_cast<double>(generator()) / 4294967296.0 - 0.5;
             }
         }
-        return result;
+        return a;
     }
 
-    // ========================================================================
-
-    template <typename TLHS, typename TRHS>
-    class MatrixExpr
+    static void test_21()
     {
-    private:
-        const TLHS& m_lhs;
-        const TRHS& m_rhs;
+        std::cout << "Expression Template 21: LU Factorization" << std::endl;
 
-    public:
-        MatrixExpr(const TLHS& lhs, const TRHS& rhs) : m_rhs{ rhs }, m_lhs{ lhs } {}
+        // a zero on the diagonal: row swap required
+        Matrix swap{ 2, 2 };
+        swap(0, 0) = 0.0; swap(1, 0) = 1.0;
+        swap(0, 1) = 2.0; swap(1, 1) = 3.0;
+        std::cout << "det(swap) = " << LU{ swap }.determinant() << std::endl;       // -2
 
-        double operator() (size_t x, size_t y) const {
+        // several panels, the last one narrower - solve for a known solution
+        constexpr size_t n{ 300 };
+        const Matrix a{ test_21_matrix(n) };
 
-            if constexpr (Verbose) {
-                double l { m_lhs(x, y) };
-                double r { m_rhs(x, y) };
-                std::cout << "MatrixExpr:: adding " << l << '+' << r << std::endl;
-                double tmp{ l + r };
-                return tmp;
-            }
-            else {
-                return m_lhs(x, y) + m_rhs(x, y);
+        Vector<> expected(n), b(n);
+        for (size_t i{}; i != n; ++i) {
+            expected[i] = static_cast<double>(1 + i % 5);
+        }
+        for (size_t y{}; y != n; ++y) {
+            double sum{};
+            for (size_t x{}; x != n; ++x) {
+                sum += a(x, y) * expected[x];
             }
+            b[y] = sum;
         }
-    };
 
-    template <typename TLHS, typename TRHS>
-    MatrixExpr<TLHS, TRHS> operator+(const TLHS& lhs, const TLHS& rhs) {
-        return MatrixExpr<TLHS, TRHS>(lhs, rhs);
+        const LU lu{ a };
+        const Vector<> x{ lu.solve(b) };
+        std::cout << "max. error of x: " << max(abs(x - expected)) << std::endl;      // ~1e-13
+
+        // same factors as the unblocked textbook version
+        Matrix naive{ a };
+        const std::vector<size_t> pivots{ luNaive(naive) };
+        std::cout << "same pivots: " << std::boolalpha << (pivots == lu.pivots()) << std::endl;   // true
+        std::cout << "max. deviation of the factors: " << max(abs(lu.factors() - naive)) << std::endl;  // ~1e-13
     }
 
-    // ========================================================================
+    // =====================================================================================
 
-    static void test_01()
-    {
-        std::cout << "Expression Template 01: Classical Approach" << std::endl;
+    // 'result = a1 + ... + aN' for matrix sizes from L1- to DRAM-resident and
+    // 2 to 8 operands, evaluated three ways:
+    //   classical: ClassicalMatrix, operator+ (one temporary per addition)
+    //   fused:     addN (add3 generalized, one loop, one temporary)
+    //   et:        expression templates (no temporary, SIMD, parallel above ParallelThreshold)
+    // One CSV line per measurement - times per evaluation, the bandwidth counts
+    // the N operands read and the result written once (what the fused loop moves)
 
-        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
-        Matrix result = a + b + c + d;  // result(x, y) = 10 
-    }
+    // evaluations per sample: small matrices are repeated to be measurable
+    constexpr size_t BenchmarkSampleElements{ 4 * 1024 * 1024 };
 
-    static void test_02()
+    struct BenchmarkResult
     {
-        std::cout << "Expression Template 02:" << std::endl;
+        double median;   // nanoseconds per evaluation
+        double min;
+    };
 
-        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
-        Matrix result{};
+    template <typename TFunc>
+    static BenchmarkResult test_04_benchmark_measure(size_t elements, TFunc func)
+    {
+        const size_t repetitions{ std::max<size_t>(BenchmarkSampleElements / elements, 1) };
 
-        // adding 2 matrices
-        MatrixExpr<Matrix, Matrix> sumAB(a, b);
-        for (size_t y = 0; y != a.getRows(); ++y) {
-            for (size_t x = 0; x != a.getCols(); ++x) {
-                result(x, y) = sumAB(x, y);
-            }
-        }
+        func();   // warm-up: page faults, caches, worker threads
 
-        // adding 3 matrices
-        MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix> sumABC(sumAB, c);
-        for (size_t y = 0; y != a.getRows(); ++y) {
-            for (size_t x = 0; x != a.getCols(); ++x) {
-                result(x, y) = sumABC(x, y);
+        std::vector<double> samples;
+        for (int i = 0; i < Iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t n{}; n != repetitions; ++n) {
+                func();
             }
-        }
+            auto end = std::chrono::steady_clock::now();
 
-        // adding 4 matrices
-        MatrixExpr<MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix>, Matrix> sumABCD{ sumABC, d };
-        for (size_t y = 0; y != a.getRows(); ++y) {
-            for (size_t x = 0; x != a.getCols(); ++x) {
-                result(x, y) = sumABCD(x, y);
-            }
+            std::chrono::duration<double, std::nano> duration{ end - start };
+            samples.push_back(duration.count() / static_cast<double>(repetitions));
         }
+
+        std::sort(samples.begin(), samples.end());
+        return { samples[samples.size() / 2], samples.front() };
     }
 
-    static void test_03()
+    static void test_04_benchmark_report(const char* variant, size_t n, size_t operands, BenchmarkResult time)
     {
-        std::cout << "Expression Template 03: Expression Templates Approach" << std::endl;
+        const double elements{ static_cast<double>(n * n) };
+        const double bytes{ static_cast<double>(operands + 1) * elements * sizeof(double) };
 
-        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 };
-        Matrix result{};
+        std::cout << "expression_sum," << variant << ',' << n << ',' << operands << ','
+            << time.median << ',' << time.min << ','
+            << bytes / time.median << ','          // bytes per ns == GB/s
+            << elements / time.median << std::endl;
+    }
 
-        // adding 4 matrices using modified operator=
-        // MatrixExpr<Matrix, Matrix> sumAB{ a, b };
-        // MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix> sumABC{ sumAB, c };
-        // MatrixExpr<MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix>, Matrix> sumABCD{ sumABC, d };
+    template <size_t N>
+    static void test_04_benchmark_operands(size_t n)
+    {
+        std::vector<Matrix<>> operands;
+        std::vector<ClassicalMatrix> classicalOperands;
+        operands.reserve(N);
+        classicalOperands.reserve(N);
+        for (size_t i{}; i != N; ++i) {
+            operands.emplace_back(n, n);
+            operands.back() = Scalar{ static_cast<double>(i + 1) };
 
-        // or - using template argument type deduction:
-        MatrixExpr sumAB{ a, b };
-        MatrixExpr sumABC{ sumAB, c };
-        MatrixExpr sumABCD{ sumABC, d };
+            classicalOperands.emplace_back(n, n, static_cast<double>(i + 1));
+        }
 
-        result = sumABCD;
+        Matrix<> result{ n, n };
+        ClassicalMatrix classicalResult{ n, n };
+
+        // MatrixExpr{ MatrixExpr{ a1, a2 }, a3 } ...
+        auto lazySum = [](const auto& first, const auto&... rest) {
+            auto expr = [](const auto& self, const auto& lhs, const auto& rhs, const auto&... tail) {
+                if constexpr (sizeof...(tail) == 0) {
+                    return MatrixExpr{ lhs, rhs };
+                }
+                else {
+                    return self(self, MatrixExpr{ lhs, rhs }, tail...);
+                }
+            };
+            return expr(expr, first, rest...);
+        };
+
+        [&] <size_t... I> (std::index_sequence<I...>) {
+
+            BenchmarkResult time{ test_04_benchmark_measure(n * n, [&] { classicalResult = (... + classicalOperands[I]); }) };
+            test_04_benchmark_report("classical", n, N, time);
+
+            time = test_04_benchmark_measure(n * n, [&] { result = addN(operands[I]...); });
+            test_04_benchmark_report("fused", n, N, time);
+
+            const auto expr{ lazySum(operands[I]...) };
+            time = test_04_benchmark_measure(n * n, [&] { result = expr; });
+            test_04_benchmark_report("et", n, N, time);
+
+        } (std::make_index_sequence<N>{});
+
+        // all variants compute the same sum
+        if (result(n - 1, n - 1) != static_cast<double>(N * (N + 1) / 2) || classicalResult(n - 1, n - 1) != result(n - 1, n - 1)) {
+            std::cout << "expression_sum: wrong result" << std::endl;
+        }
+    }
+
+    static void test_04_benchmark()
+    {
+        std::cout << "Expression Templates 04 (Benchmark):" << std::endl;
+        std::cout << "benchmark,variant,size,operands,median_ns,min_ns,gb_per_s,elements_per_ns" << std::endl;
+
+        // 8 KB, 128 KB, 2 MB and 18 MB per matrix
+        for (size_t n : { 32, 128, 512, 1536 }) {
+            [&] <size_t... N> (std::index_sequence<N...>) {
+                (test_04_benchmark_operands<N + 2>(n), ...);
+            } (std::make_index_sequence<7>{});
+        }
     }
 
     // =====================================================================================
 
-    static void test_04a_benchmark(
-        int iterations,
-        Matrix& result,
-        const Matrix& a1,
-        const Matrix& a2,
-        const Matrix& a3,
-        const Matrix& a4,
-        const Matrix& a5)
+    // 'result = a1 + a2 + a3 + a4 + a5' for one element type: narrower types
+    // move fewer bytes and process more elements per SIMD instruction
+    template <typename T>
+    static void test_11_benchmark_element_type(const char* name)
     {
+        Matrix<T> a1{ T{ 1 } }, a2{ T{ 2 } }, a3{ T{ 3 } }, a4{ T{ 4 } }, a5{ T{ 5 } };
+        Matrix<T> result{};
+
+        MatrixExpr sumAB{ a1, a2 };
+        MatrixExpr sumABC{ sumAB, a3 };
+        MatrixExpr sumABCD{ sumABC, a4 };
+        MatrixExpr sumABCDE{ sumABCD, a5 };
+
         auto start = std::chrono::high_resolution_clock::now();
-        for (int i = 0; i < iterations; ++i) {
-            result = a1 + a2 + a3 + a4 + a5;
+        for (int i = 0; i < Iterations; ++i) {
+            result = sumABCDE;
         }
         auto end = std::chrono::high_resolution_clock::now();
 
-        std::cout
+        std::cout << name << " (" << Packet<T>::Lanes << " lanes): "
             << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
             << " milliseconds." << std::endl;
     }
 
-    static void test_04b_benchmark(
-        int iterations,
-        Matrix& result,
-        const Matrix& a1,
-        const Matrix& a2,
-        const Matrix& a3,
-        const Matrix& a4,
-        const Matrix& a5)
+    static void test_11_benchmark()
     {
-        // adding 5 matrices with expression template approach
-        //MatrixExpr<Matrix, Matrix> sumAB{ a1, a2 };
-        //MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix> sumABC{ sumAB, a3 };
-        //MatrixExpr<MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix>, Matrix> sumABCD{ sumABC, a4 };
-        //MatrixExpr<MatrixExpr<MatrixExpr<MatrixExpr<Matrix, Matrix>, Matrix>, Matrix>, Matrix> sumABCDE{ sumABCD, a5 };
+        std::cout << "Expression Templates 11 (Benchmark Element Types):" << std::endl;
+
+        test_11_benchmark_element_type<double>("double");
+        test_11_benchmark_element_type<float>("float");
+        test_11_benchmark_element_type<std::int32_t>("int32_t");
+        test_11_benchmark_element_type<std::int16_t>("int16_t");
+    }
+
+    // =====================================================================================
+
+    // 'result = a1 + ... + a5' with packed and with padded rows
+    static void test_12_benchmark_padding(size_t cols, RowPadding padding, const char* name)
+    {
+        constexpr size_t BenchmarkRows{ 512 };
+
+        Matrix<> a1{ cols, BenchmarkRows, padding }, a2{ cols, BenchmarkRows, padding };
+        Matrix<> a3{ cols, BenchmarkRows, padding }, a4{ cols, BenchmarkRows, padding };
+        Matrix<> a5{ cols, BenchmarkRows, padding }, result{ cols, BenchmarkRows, padding };
 
-        // or - using template argument type deduction:
         MatrixExpr sumAB{ a1, a2 };
         MatrixExpr sumABC{ sumAB, a3 };
         MatrixExpr sumABCD{ sumABC, a4 };
         MatrixExpr sumABCDE{ sumABCD, a5 };
 
+        result = sumABCDE;   // warm-up
+
         auto start = std::chrono::high_resolution_clock::now();
-        for (int i = 0; i < iterations; ++i) {
+        for (int i = 0; i < Iterations; ++i) {
             result = sumABCDE;
         }
         auto end = std::chrono::high_resolution_clock::now();
 
-        std::cout
-            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
-            << " milliseconds." << std::endl;
+        std::cout << cols << " columns, " << name << " (stride " << result.getStride() << "): "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+            << " microseconds." << std::endl;
     }
 
-    static void test_04_benchmark()
+    static void test_12_benchmark()
     {
-        std::cout << "Expression Templates 04 (Benchmark):" << std::endl;
+        std::cout << "Expression Templates 12 (Benchmark Row Padding):" << std::endl;
 
-        Matrix a{ 1.0 }, b{ 2.0 }, c{ 3.0 }, d{ 4.0 }, e{ 5.0 };
-        Matrix result{};
+        for (size_t cols : { 1000, 1024, 2048 }) {
+            test_12_benchmark_padding(cols, RowPadding::None, "packed");
+            test_12_benchmark_padding(cols, RowPadding::CacheLine, "padded");
+        }
+    }
+
+    // =====================================================================================
+
+    // BLAS level 1: expression templates vs. hand-written loops, one CSV line per measurement
+    // (bytes: the vectors read and written once)
+    static void test_19_benchmark_report(const char* operation, const char* variant, size_t n, size_t vectors, BenchmarkResult time)
+    {
+        const double bytes{ static_cast<double>(vectors * n * sizeof(double)) };
+
+        std::cout << "blas1," << operation << ',' << variant << ',' << n << ','
+            << time.median << ',' << time.min << ',' << bytes / time.median << std::endl;
+    }
+
+    static void test_19_benchmark()
+    {
+        std::cout << "Expression Templates 19 (Benchmark BLAS Level 1):" << std::endl;
+        std::cout << "benchmark,operation,variant,size,median_ns,min_ns,gb_per_s" << std::endl;
+
+        double checksum{};
+
+        // 8 KB, 800 KB and 80 MB per vector
+        for (size_t n : { 1000, 100'000, 10'000'000 }) {
+
+            Vector<> x(n, 1.0), y(n, 2.0), w(n);
+            double* px{ x.data() };
+            double* py{ y.data() };
+            double* pw{ w.data() };
+
+            BenchmarkResult time{ test_04_benchmark_measure(n, [&] {
+                for (size_t i{}; i != n; ++i) {
+                    py[i] = 1e-9 * px[i] + py[i];
+                }
+            }) };
+            test_19_benchmark_report("axpy", "loop", n, 3, time);
+
+            time = test_04_benchmark_measure(n, [&] { axpy(1e-9, x, y); });
+            test_19_benchmark_report("axpy", "et", n, 3, time);
+
+            time = test_04_benchmark_measure(n, [&] {
+                for (size_t i{}; i != n; ++i) {
+                    pw[i] = 0.5 * px[i] + 0.25 * py[i];
+                }
+            });
+            test_19_benchmark_report("waxpby", "loop", n, 3, time);
+
+            time = test_04_benchmark_measure(n, [&] { waxpby(0.5, x, 0.25, y, w); });
+            test_19_benchmark_report("waxpby", "et", n, 3, time);
+
+            time = test_04_benchmark_measure(n, [&] {
+                double product{};
+                for (size_t i{}; i != n; ++i) {
+                    product += px[i] * py[i];
+                }
+                checksum += product;
+            });
+            test_19_benchmark_report("dot", "loop", n, 2, time);
+
+            time = test_04_benchmark_measure(n, [&] { checksum += dot(x, y); });
+            test_19_benchmark_report("dot", "et", n, 2, time);
+
+            time = test_04_benchmark_measure(n, [&] { checksum += nrm2(x); });
+            test_19_benchmark_report("nrm2", "et", n, 1, time);
+        }
+
+        std::cout << "checksum: " << (checksum > 0.0) << std::endl;
+    }
+
+    // =====================================================================================
+
+    static void test_06()
+    {
+        std::cout << "Expression Template 06: Matrix Product" << std::endl;
+
+        // small integers: all results are exact
+        Matrix a{ 70, 100 }, b{ 90, 70 }, d{ 90, 100 }, e{ 90, 100 };
+        for (size_t y{}; y != 100; ++y) {
+            for (size_t x{}; x != 90; ++x) {
+                if (x < 70) {
+                    a(x, y) = static_cast<double>((x + 2 * y) % 7) - 3.0;
+                }
+                if (y < 70) {
+                    b(x, y) = static_cast<double>((3 * x + y) % 5) - 2.0;
+                }
+                d(x, y) = static_cast<double>(x % 3);
+                e(x, y) = static_cast<double>(y % 4);
+            }
+        }
 
-        std::cout << "Start:" << std::endl;
-        test_04a_benchmark(Iterations, result, a, b, c, d, e);
-        test_04b_benchmark(Iterations, result, a, b, c, d, e);
-        std::cout << "Done." << std::endl;
+        const Matrix naive{ multiplyNaive(a, b) };
+        Matrix result{ 90, 100 }, expected{ 90, 100 };
+
+        // terms around the product are fused into the write-back of the kernel
+        result = a * b + d + e;
+        expected = naive + d + e;
+        std::cout << "a * b + d + e:    " << max(abs(result - expected)) << std::endl;   // 0
+
+        result = d - 2.0 * (a * b - e);
+        expected = d - 2.0 * (naive - e);
+        std::cout << "d - 2(a * b - e): " << max(abs(result - expected)) << std::endl;  // 0
+
+        result = -(a * b);
+        std::cout << "-(a * b):         " << max(abs(result + naive)) << std::endl;      // 0
+
+        // the addend must have the size of the product
+        try {
+            result = a * b + Matrix{ 8, 8 };
+        }
+        catch (const std::invalid_argument& ex) {
+            std::cout << ex.what() << std::endl;     // Matrix product: addend has wrong dimensions
+        }
+    }
+
+    static void test_06_benchmark_gemm()
+    {
+        std::cout << "Expression Templates 06 (Benchmark Matrix Product):" << std::endl;
+
+        // beyond this size the naive triple loop would take minutes
+        constexpr size_t NaiveLimit{ 1024 };
+
+        for (size_t n : { 256, 1024, 2048 }) {
+
+            Matrix a{ n, n }, b{ n, n }, d{ n, n };
+            for (size_t y{}; y != n; ++y) {
+                for (size_t x{}; x != n; ++x) {
+                    a(x, y) = static_cast<double>((x + 2 * y) % 7) - 3.0;
+                    b(x, y) = static_cast<double>((3 * x + y) % 5) - 2.0;
+                    d(x, y) = 1.0;
+                }
+            }
+
+            const double flops{ 2.0 * n * n * n };
+
+            Matrix result{ n, n };
+            auto start = std::chrono::high_resolution_clock::now();
+            result = a * b + d;     // product and addition fused in one kernel
+            auto end = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> seconds{ end - start };
+            std::cout << n << 'x' << n << ": blocked: " << seconds.count() * 1000.0
+                << " milliseconds, " << flops / seconds.count() * 1e-9 << " GFLOP/s" << std::endl;
+
+            if (n > NaiveLimit) {
+                continue;
+            }
+
+            start = std::chrono::high_resolution_clock::now();
+            Matrix naive{ multiplyNaive(a, b) };
+            end = std::chrono::high_resolution_clock::now();
+            seconds = end - start;
+            std::cout << n << 'x' << n << ": naive:   " << seconds.count() * 1000.0
+                << " milliseconds, " << flops / seconds.count() * 1e-9 << " GFLOP/s" << std::endl;
+
+            double deviation{};
+            for (size_t y{}; y != n; ++y) {
+                for (size_t x{}; x != n; ++x) {
+                    deviation = std::max(deviation, std::abs(result(x, y) - naive(x, y) - 1.0));
+                }
+            }
+            std::cout << n << 'x' << n << ": max. deviation: " << deviation << std::endl;
+        }
+    }
+
+    static void test_21_benchmark()
+    {
+        std::cout << "Expression Templates 21 (Benchmark LU Factorization):" << std::endl;
+
+        for (size_t n : { 256, 512, 1024 }) {
+
+            const Matrix a{ test_21_matrix(n) };
+            const double flops{ 2.0 / 3.0 * n * n * n };
+
+            Matrix naive{ a };
+            auto start = std::chrono::high_resolution_clock::now();
+            luNaive(naive);
+            auto end = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> seconds{ end - start };
+            std::cout << n << 'x' << n << ": naive:   " << seconds.count() * 1000.0
+                << " milliseconds, " << flops / seconds.count() * 1e-9 << " GFLOP/s" << std::endl;
+
+            start = std::chrono::high_resolution_clock::now();
+            const LU lu{ a };
+            end = std::chrono::high_resolution_clock::now();
+            seconds = end - start;
+            std::cout << n << 'x' << n << ": blocked: " << seconds.count() * 1000.0
+                << " milliseconds, " << flops / seconds.count() * 1e-9 << " GFLOP/s" << std::endl;
+
+            std::cout << n << 'x' << n << ": max. deviation: " << max(abs(lu.factors() - naive)) << std::endl;
+        }
     }
 }
 
@@ -311,6 +5053,28 @@ void main_expression_templates_vectorBased()
     test_02();            // <== expression templates approach
     test_03();            // <== expression templates approach using modified operator=
     test_04_benchmark();  // <== benchmark
+    test_05();            // <== subtraction, scaling, Hadamard product and unary functions
+    test_06();            // <== lazy matrix product, terms around it fused into the kernel
+    test_06_benchmark_gemm();  // <== lazy matrix product vs. naive triple loop
+    test_07();            // <== reductions
+    test_08();            // <== transpose, block, row, column and strided views
+    test_09();            // <== deferred, fused evaluation of several assignments
+    test_10();            // <== sparse matrices in CSR format
+    test_11();            // <== element types float, int32_t and int16_t, mixed expressions
+    test_11_benchmark();  // <== benchmark element types
+    test_12();            // <== cache-line aligned storage, padded rows
+    test_12_benchmark();  // <== benchmark row padding at 1024 and 2048 columns
+    test_13();            // <== out-of-core matrices in memory-mapped files
+    test_14();            // <== binary matrix files, zero-copy load
+    test_15();            // <== aliasing-aware assignment, e.g. 'a = transpose(a)'
+    test_16();            // <== common subexpressions, evaluated once per element
+    test_17();            // <== stencils and convolutions with boundary handling
+    test_18();            // <== cost instrumentation of assignments (opt-in)
+    test_19();            // <== vectors, BLAS level 1 (axpy, scal, waxpby, dot, nrm2)
+    test_19_benchmark();  // <== benchmark BLAS level 1 against hand-written loops
+    test_20();            // <== branch-free masked selection, 'where(a > b, a - b, 0)'
+    test_21();            // <== blocked LU factorization with partial pivoting, linear solve
+    test_21_benchmark();  // <== benchmark LU factorization: blocked vs. textbook version
 }
 
 // =====================================================================================